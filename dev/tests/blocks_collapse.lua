@@ -0,0 +1,69 @@
+-- Measures ticks time while a large layer of grounded blocks collapses
+local util = require "core:tests_util"
+util.create_demo_world("core:default")
+app.set_setting("chunks.load-distance", 4)
+app.set_setting("chunks.load-speed", 1)
+
+local pid = player.create("Xerxes")
+player.set_pos(pid, 0, 150, 0)
+app.sleep_until(function () return block.get(0, 0, 0) ~= -1 end)
+
+local SIZE = 64
+local Y = 120
+local stone = block.index("base:stone")
+local grass = block.index("base:grass")
+
+local function fill(id, y)
+    block.begin_edit()
+    for z = -SIZE/2, SIZE/2 - 1 do
+        for x = -SIZE/2, SIZE/2 - 1 do
+            block.set(x, y, z, id, 0, true)
+        end
+    end
+    block.commit_edit()
+end
+
+local function count(id, y)
+    local n = 0
+    for z = -SIZE/2, SIZE/2 - 1 do
+        for x = -SIZE/2, SIZE/2 - 1 do
+            if block.get(x, y, z) == id then
+                n = n + 1
+            end
+        end
+    end
+    return n
+end
+
+fill(stone, Y)
+fill(grass, Y + 1)
+app.tick()
+
+-- remove support with neighbours notification
+block.begin_edit()
+for z = -SIZE/2, SIZE/2 - 1 do
+    for x = -SIZE/2, SIZE/2 - 1 do
+        block.set(x, Y, z, 0)
+    end
+end
+block.commit_edit()
+
+local ticks = 0
+local max_time = 0
+local total_time = 0
+while count(grass, Y + 1) > 0 do
+    local start = time.uptime()
+    app.tick()
+    local elapsed = (time.uptime() - start) * 1000
+    max_time = math.max(max_time, elapsed)
+    total_time = total_time + elapsed
+    ticks = ticks + 1
+    assert(ticks < 1000, "collapse did not finish")
+end
+
+print(string.format(
+    "collapse of %d blocks: %d ticks, avg %.2f ms, max %.2f ms",
+    SIZE * SIZE, ticks, total_time / ticks, max_time
+))
+app.close_world(true)
+app.delete_world("demo")
@@ -0,0 +1,88 @@
+-- Compares per-block sets with batched edit on a fill: both must produce
+-- the same blocks and lights
+local util = require "core:tests_util"
+util.create_demo_world("core:default")
+app.set_setting("chunks.load-distance", 3)
+app.set_setting("chunks.load-speed", 1)
+
+local pid = player.create("Xerxes")
+player.set_pos(pid, 0, 100, 0)
+app.sleep_until(function () return block.get(0, 0, 0) ~= -1 end)
+
+local SIZE = 24
+local Y = 60
+local stone = block.index("base:stone")
+
+local function fill(id)
+    for y = Y, Y + SIZE - 1 do
+        for z = -SIZE/2, SIZE/2 - 1 do
+            for x = -SIZE/2, SIZE/2 - 1 do
+                block.set(x, y, z, id)
+            end
+        end
+    end
+end
+
+local function measure(id, batched)
+    local start = time.uptime()
+    if batched then
+        block.begin_edit()
+        fill(id)
+        assert(block.commit_edit() == SIZE * SIZE * SIZE)
+    else
+        fill(id)
+    end
+    return (time.uptime() - start) * 1000
+end
+
+-- blocks and lights of the filled zone and its neighbours
+local function snapshot()
+    local ids = {}
+    local lights = {}
+    for y = Y - 1, Y + SIZE do
+        for z = -SIZE/2 - 1, SIZE/2 do
+            for x = -SIZE/2 - 1, SIZE/2 do
+                table.insert(ids, block.get(x, y, z))
+                table.insert(lights, block.get_light(x, y, z))
+            end
+        end
+    end
+    return {ids=ids, lights=lights}
+end
+
+local function check_equal(expected, actual, stage)
+    for i = 1, #expected.ids do
+        if expected.ids[i] ~= actual.ids[i] then
+            error(string.format(
+                "%s: block #%d id %d ~= %d",
+                stage, i, actual.ids[i], expected.ids[i]
+            ))
+        end
+        if expected.lights[i] ~= actual.lights[i] then
+            error(string.format(
+                "%s: block #%d light %d ~= %d",
+                stage, i, actual.lights[i], expected.lights[i]
+            ))
+        end
+    end
+end
+
+-- both modes start from the same cleared zone
+fill(0)
+
+local plain = measure(stone, false)
+local plainFilled = snapshot()
+plain = plain + measure(0, false)
+local plainCleared = snapshot()
+
+local batched = measure(stone, true)
+check_equal(plainFilled, snapshot(), "fill")
+batched = batched + measure(0, true)
+check_equal(plainCleared, snapshot(), "clear")
+
+print(string.format(
+    "fill %d blocks: per-block %.2f ms, batched %.2f ms (x%.1f)",
+    SIZE * SIZE * SIZE * 2, plain, batched, plain / batched
+))
+app.close_world(true)
+app.delete_world("demo")
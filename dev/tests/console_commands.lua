@@ -0,0 +1,43 @@
+-- Measures per-command overhead replaying a command log
+local ITERATIONS = 2000
+
+console.add_command(
+    "bench.tp entity:sel=$bench.entity x:num~bench.x y:num~bench.y z:num~bench.z",
+    "Benchmark command",
+    function(args, kwargs) end
+)
+console.add_command(
+    "bench.mode mode:[replace|destruct|none] {depth:int=1}",
+    "Benchmark command",
+    function(args, kwargs) end
+)
+console.set("bench.entity", 1)
+console.set("bench.x", 0.0)
+console.set("bench.y", 100.0)
+console.set("bench.z", 0.0)
+
+-- command log entries with a varying argument
+local log = {
+    "bench.tp @2 %d ~5 -10",
+    "bench.tp 0 ~ %d",
+    "bench.mode replace depth=%d",
+    "bench.mode destruct",
+}
+
+local function measure(name, gen)
+    local start = time.uptime()
+    for i = 1, ITERATIONS do
+        for _, command in ipairs(log) do
+            console.execute(string.format(command, gen(i)))
+        end
+    end
+    local elapsed = (time.uptime() - start) * 1e6
+    print(string.format(
+        "%s: %.3f us per command", name, elapsed / (ITERATIONS * #log)
+    ))
+end
+
+-- repeated commands are taken from the parsed prompts cache
+measure("repeated", function(i) return 1 end)
+-- unique commands are parsed every time
+measure("unique", function(i) return i end)
@@ -0,0 +1,16 @@
+-- Measures heightmap resize time for each interpolation mode
+local ITERATIONS = 200
+
+for _, interpolation in ipairs({"nearest", "linear", "cubic"}) do
+    local start = time.uptime()
+    for i = 1, ITERATIONS do
+        local map = Heightmap(64, 64)
+        map:resize(256, 256, interpolation)
+        map:crop(16, 16, 224, 224)
+    end
+    local elapsed = (time.uptime() - start) * 1000
+    print(string.format(
+        "%s: %.3f ms per 64x64 -> 256x256 resize",
+        interpolation, elapsed / ITERATIONS
+    ))
+end
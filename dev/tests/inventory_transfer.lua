@@ -0,0 +1,49 @@
+-- Measures bulk transfer between large inventories scaling with their size
+local util = require "core:tests_util"
+util.create_demo_world("core:default")
+
+local items = {
+    item.index("base:stone.item"),
+    item.index("base:dirt.item"),
+    item.index("base:sand.item"),
+}
+
+local function measure(size)
+    local src = inventory.create(size)
+    local dst = inventory.create(size)
+    for i = 0, size - 1 do
+        -- half of the slots hold single items merging into existing stacks
+        local count = i % 2 == 0 and 1 or 64
+        inventory.set(src, i, items[i % #items + 1], count)
+    end
+
+    local start = time.uptime()
+    for i = 0, size - 1 do
+        inventory.move(src, i, dst)
+    end
+    for _, id in ipairs(items) do
+        while true do
+            local slot = inventory.find_by_item(dst, id, 0, nil, 64)
+            if slot == nil then
+                break
+            end
+            inventory.move(dst, slot, src)
+        end
+    end
+    local elapsed = (time.uptime() - start) * 1000
+
+    inventory.remove(src)
+    inventory.remove(dst)
+    return elapsed
+end
+
+local prev
+for _, size in ipairs({256, 1024, 4096}) do
+    local elapsed = measure(size)
+    print(string.format(
+        "%d slots: %.3f ms (%.3f us per slot)%s",
+        size, elapsed, elapsed * 1000 / size,
+        prev and string.format(", x%.1f", elapsed / prev) or ""
+    ))
+    prev = elapsed
+end
@@ -0,0 +1,22 @@
+-- Allocates many short-lived tables per tick and reports tick times
+local TICKS = 200
+local TABLES_PER_TICK = 20000
+
+local max_tick = 0
+local total = 0
+for _ = 1, TICKS do
+    local start = time.uptime()
+    local last
+    for i = 1, TABLES_PER_TICK do
+        last = {i, i + 1, i + 2, name = "entry"..i}
+    end
+    assert(last[1] == TABLES_PER_TICK)
+    local tick = time.uptime() - start
+    max_tick = math.max(max_tick, tick)
+    total = total + tick
+    app.tick()
+end
+print(string.format(
+    "lua gc: avg tick %.3f ms, max tick %.3f ms, memory %d KiB",
+    total / TICKS * 1000, max_tick * 1000, collectgarbage("count")
+))
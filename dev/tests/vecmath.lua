@@ -0,0 +1,52 @@
+local function assert_near(a, b)
+    for i = 1, #a do
+        assert(math.abs(a[i] - b[i]) < 1e-4)
+    end
+end
+
+-- FFI vectors produce the same results as tables
+local ta, tb = {1, 2, 3}, {4, -5, 6}
+local fa, fb = vec3.new(ta), vec3.new(4, -5, 6)
+assert(#fa == 3 and fa[2] == 2)
+
+assert_near(vec3.add(ta, tb), vec3.add(fa, fb))
+assert_near(vec3.sub(ta, tb), vec3.sub(fa, fb))
+assert_near(vec3.mul(ta, 2.5), vec3.mul(fa, 2.5))
+assert_near(vec3.div(ta, tb), vec3.div(fa, fb))
+assert_near(vec3.normalize(ta), vec3.normalize(fa))
+assert_near(vec3.inverse(ta), vec3.inverse(fa))
+assert(math.abs(vec3.dot(ta, tb) - vec3.dot(fa, fb)) < 1e-4)
+assert(math.abs(vec3.length(ta) - vec3.length(fa)) < 1e-4)
+
+-- native functions accept FFI vectors and matrices
+assert_near(vec3.abs(ta), vec3.abs(fa))
+assert(vec3.tostring(fa) == vec3.tostring(ta))
+
+local tm = mat4.rotate({0, 1, 0}, 30)
+local fm = mat4.new(tm)
+assert_near(mat4.mul(tm, tm), mat4.mul(fm, fm))
+assert_near(mat4.mul(tm, {1, 2, 3, 1}), mat4.mul(fm, vec4.new(1, 2, 3, 1)))
+assert_near(mat4.inverse(tm), mat4.inverse(fm))
+local dst = mat4.new()
+mat4.translate(fm, fa, dst)
+assert_near(mat4.translate(tm, ta), dst)
+
+-- mod-style math loop
+local function bench(a, b, m, dst)
+    local start = time.uptime()
+    for _ = 1, 200000 do
+        local d = vec3.sub(a, b)
+        local v = vec3.mul(vec3.normalize(d), 0.5)
+        vec3.add(a, v, a)
+        mat4.mul(m, m, dst)
+    end
+    return time.uptime() - start
+end
+
+local ttime = bench({1, 2, 3}, {4, 5, 6}, tm, mat4.idt())
+local ftime = bench(
+    vec3.new(1, 2, 3), vec3.new(4, 5, 6), fm, mat4.new()
+)
+print(string.format(
+    "vecmath loop: tables %.3fs, ffi %.3fs", ttime, ftime
+))
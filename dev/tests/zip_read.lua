@@ -0,0 +1,29 @@
+-- Reads files of a mounted ZIP pack and reports read times
+local FILES = 200
+local PASSES = 5
+
+file.mkdirs("config:zipbench/textures")
+for i = 1, FILES do
+    local text = string.rep("entry "..i.."\n", 100)
+    file.write("config:zipbench/textures/"..i..".json", text)
+end
+file.create_zip("config:zipbench", "config:zipbench.zip")
+file.remove_tree("config:zipbench")
+
+local entry_point = file.mount("config:zipbench.zip")
+local times = {}
+for pass = 1, PASSES do
+    local start = time.uptime()
+    for i = 1, FILES do
+        local text = file.read(entry_point..":textures/"..i..".json")
+        assert(#text > 0)
+    end
+    times[pass] = time.uptime() - start
+end
+file.unmount(entry_point)
+file.remove("config:zipbench.zip")
+
+print(string.format(
+    "zip read: first pass %.3f ms, cached pass %.3f ms (%d files)",
+    times[1] * 1000, times[PASSES] * 1000, FILES
+))
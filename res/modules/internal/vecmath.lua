@@ -0,0 +1,234 @@
+-- FFI-backed vectors and matrices for vecn/mat4 libraries.
+-- Operations with cdata arguments are implemented in Lua to stay
+-- JIT-compilable; tables are still processed by the native functions.
+
+local FFI = ffi
+local _type = type
+local _sqrt = math.sqrt
+
+-- must match lua::VECMATH_TAG
+local TAG = 0x564D0000
+
+FFI.cdef[[
+    typedef struct { uint32_t tag; float data[2]; } vc_vec2_t;
+    typedef struct { uint32_t tag; float data[3]; } vc_vec3_t;
+    typedef struct { uint32_t tag; float data[4]; } vc_vec4_t;
+    typedef struct { uint32_t tag; float data[16]; } vc_mat4_t;
+]]
+
+local function define_type(ctypename, n)
+    local typename = n == 16 and "mat4" or "vec"..n
+    local mt = {
+        __index = function(self, i)
+            if _type(i) == "number" and i >= 1 and i <= n then
+                return self.data[i - 1]
+            end
+            return nil
+        end,
+        __newindex = function(self, i, value)
+            if _type(i) ~= "number" or i < 1 or i > n then
+                error("invalid "..typename.." index "..tostring(i))
+            end
+            self.data[i - 1] = value
+        end,
+        __len = function(self)
+            return n
+        end,
+    }
+    return FFI.metatype(ctypename, mt)
+end
+
+local vec_types = {
+    [2] = define_type("vc_vec2_t", 2),
+    [3] = define_type("vc_vec3_t", 3),
+    [4] = define_type("vc_vec4_t", 4),
+}
+local mat4_t = define_type("vc_mat4_t", 16)
+
+-- passing nil arguments explicitly would select other native overload
+local function call_native(native, a, b, dst)
+    if dst ~= nil then
+        return native(a, b, dst)
+    elseif b ~= nil then
+        return native(a, b)
+    end
+    return native(a)
+end
+
+local function add(a, b) return a + b end
+local function sub(a, b) return a - b end
+local function mul(a, b) return a * b end
+local function div(a, b) return a / b end
+
+local function complete_vec_lib(lib, n)
+    local ctype = vec_types[n]
+    local tag = TAG + n
+
+    local function is_vec(v)
+        return _type(v) == "cdata" and v.tag == tag
+    end
+
+    local function new(...)
+        local vec = ctype(tag)
+        local x = ...
+        if _type(x) == "table" or _type(x) == "cdata" then
+            for i = 1, n do
+                vec.data[i - 1] = x[i]
+            end
+        else
+            for i = 1, math.min(select('#', ...), n) do
+                vec.data[i - 1] = select(i, ...)
+            end
+        end
+        return vec
+    end
+
+    local function binop(op, native)
+        return function(a, b, dst)
+            if not is_vec(a) or (dst ~= nil and not is_vec(dst)) then
+                return call_native(native, a, b, dst)
+            end
+            local res = dst or ctype(tag)
+            if _type(b) == "number" then
+                for i = 0, n - 1 do
+                    res.data[i] = op(a.data[i], b)
+                end
+            elseif is_vec(b) then
+                for i = 0, n - 1 do
+                    res.data[i] = op(a.data[i], b.data[i])
+                end
+            else
+                return call_native(native, a, b, dst)
+            end
+            return res
+        end
+    end
+
+    local native_dot = lib.dot
+    local native_length = lib.length
+    local native_normalize = lib.normalize
+    local native_inverse = lib.inverse
+
+    lib.new = new
+    lib.add = binop(add, lib.add)
+    lib.sub = binop(sub, lib.sub)
+    lib.mul = binop(mul, lib.mul)
+    lib.div = binop(div, lib.div)
+
+    lib.dot = function(a, b)
+        if not is_vec(a) or not is_vec(b) then
+            return native_dot(a, b)
+        end
+        local sum = 0.0
+        for i = 0, n - 1 do
+            sum = sum + a.data[i] * b.data[i]
+        end
+        return sum
+    end
+
+    lib.length = function(a)
+        if not is_vec(a) then
+            return native_length(a)
+        end
+        local sum = 0.0
+        for i = 0, n - 1 do
+            sum = sum + a.data[i] * a.data[i]
+        end
+        return _sqrt(sum)
+    end
+
+    lib.normalize = function(a, dst)
+        if not is_vec(a) or (dst ~= nil and not is_vec(dst)) then
+            return call_native(native_normalize, a, dst)
+        end
+        local sum = 0.0
+        for i = 0, n - 1 do
+            sum = sum + a.data[i] * a.data[i]
+        end
+        local k = 1.0 / _sqrt(sum)
+        local res = dst or ctype(tag)
+        for i = 0, n - 1 do
+            res.data[i] = a.data[i] * k
+        end
+        return res
+    end
+
+    lib.inverse = function(a, dst)
+        if not is_vec(a) or (dst ~= nil and not is_vec(dst)) then
+            return call_native(native_inverse, a, dst)
+        end
+        local res = dst or ctype(tag)
+        for i = 0, n - 1 do
+            res.data[i] = -a.data[i]
+        end
+        return res
+    end
+end
+
+local function complete_mat4_lib(lib)
+    local tag = TAG + 16
+    local vec4_t = vec_types[4]
+    local native_mul = lib.mul
+
+    local function is_vecmath(v, size)
+        return _type(v) == "cdata" and v.tag == TAG + size
+    end
+
+    lib.new = function(src)
+        local mat = mat4_t(tag)
+        if src == nil then
+            for i = 0, 3 do
+                mat.data[i * 4 + i] = 1.0
+            end
+        else
+            for i = 1, 16 do
+                mat.data[i - 1] = src[i]
+            end
+        end
+        return mat
+    end
+
+    -- matrices are stored column-major, as glm does
+    lib.mul = function(a, b, dst)
+        if not is_vecmath(a, 16) then
+            return call_native(native_mul, a, b, dst)
+        end
+        if is_vecmath(b, 16) and (dst == nil or is_vecmath(dst, 16)) then
+            local ad, bd = a.data, b.data
+            local res = mat4_t(tag)
+            local rd = res.data
+            for c = 0, 3 do
+                for r = 0, 3 do
+                    rd[c * 4 + r] = ad[r] * bd[c * 4] +
+                                    ad[4 + r] * bd[c * 4 + 1] +
+                                    ad[8 + r] * bd[c * 4 + 2] +
+                                    ad[12 + r] * bd[c * 4 + 3]
+                end
+            end
+            if dst then
+                FFI.copy(dst.data, rd, 64)
+                return dst
+            end
+            return res
+        elseif is_vecmath(b, 4) and (dst == nil or is_vecmath(dst, 4)) then
+            local ad, bd = a.data, b.data
+            local x, y, z, w = bd[0], bd[1], bd[2], bd[3]
+            local res = dst or vec4_t(TAG + 4)
+            for r = 0, 3 do
+                res.data[r] = ad[r] * x + ad[4 + r] * y +
+                              ad[8 + r] * z + ad[12 + r] * w
+            end
+            return res
+        end
+        return call_native(native_mul, a, b, dst)
+    end
+end
+
+return {
+    complete_libs = function(vec2, vec3, vec4, mat4)
+        complete_vec_lib(vec2, 2)
+        complete_vec_lib(vec3, 3)
+        complete_vec_lib(vec4, 4)
+        complete_mat4_lib(mat4)
+    end
+}
@@ -102,6 +102,17 @@ console.add_command(
         return args[1]
     end
 )
+console.add_command(
+    "world.backup hardlinks:bool=true",
+    "Save the world and create its backup without stopping the game",
+    function(args, kwargs)
+        local folder, stall = world.backup(args[1])
+        return string.format(
+            "Backup %s captured in %.2f ms, copying in background",
+            folder, stall
+        )
+    end
+)
 console.add_command(
     "time.set value:num",
     "Set day time [0..1] where 0 is midnight, 0.5 is noon",
@@ -133,6 +144,9 @@ console.add_command(
     function(args, kwargs)
         local name, x1,y1,z1, x2,y2,z2 = unpack(args)
         local id = block.index(name)
+        -- edit left open by a script is committed first
+        block.commit_edit()
+        block.begin_edit()
         for y=y1,y2 do
             for z=z1,z2 do
                 for x=x1,x2 do
@@ -140,6 +154,7 @@ console.add_command(
                 end
             end
         end
+        block.commit_edit()
         local w = math.floor(math.abs(x2-x1+1) + 0.5)
         local h = math.floor(math.abs(y2-y1+1) + 0.5)
         local d = math.floor(math.abs(z2-z1+1) + 0.5)
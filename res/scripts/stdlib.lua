@@ -31,6 +31,7 @@ local function complete_app_lib(app)
     app.close_world = core.close_world
     app.reopen_world = core.reopen_world
     app.delete_world = core.delete_world
+    app.recompress_world = core.recompress_world
     app.reconfig_packs = core.reconfig_packs
     app.get_setting = core.get_setting
     app.set_setting = core.set_setting
@@ -283,6 +284,7 @@ local bytearray = require "core:internal/bytearray"
 Bytearray = bytearray.FFIBytearray
 Bytearray_as_string = bytearray.FFIBytearray_as_string
 Bytearray_construct = function(...) return Bytearray(...) end
+require "core:internal/vecmath".complete_libs(vec2, vec3, vec4, mat4)
 ffi = nil
 
 math.randomseed(time.uptime() * 1536227939)
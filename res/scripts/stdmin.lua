@@ -78,18 +78,21 @@ function parse_path(path)
     return string.sub(path, 1, index-1), string.sub(path, index+1, -1)
 end
 
-function pack.is_installed(packid)
-    return file.isfile(packid..":package.json")
-end
+-- pack library is not available in worker states
+if pack then
+    function pack.is_installed(packid)
+        return file.isfile(packid..":package.json")
+    end
 
-function pack.data_file(packid, name)
-    file.mkdirs("world:data/"..packid)
-    return "world:data/"..packid.."/"..name
-end
+    function pack.data_file(packid, name)
+        file.mkdirs("world:data/"..packid)
+        return "world:data/"..packid.."/"..name
+    end
 
-function pack.shared_file(packid, name)
-    file.mkdirs("config:"..packid)
-    return "config:"..packid.."/"..name
+    function pack.shared_file(packid, name)
+        file.mkdirs("config:"..packid)
+        return "config:"..packid.."/"..name
+    end
 end
 
 
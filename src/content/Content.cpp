@@ -21,7 +21,24 @@ ContentIndices::ContentIndices(
 )
     : blocks(std::move(blocks)),
       items(std::move(items)),
-      entities(std::move(entities)) {
+      entities(std::move(entities)),
+      blockProperties(this->blocks.getIterable()) {
+}
+
+BlockPropertiesTable::BlockPropertiesTable(const std::vector<Block*>& defs)
+    : flags(defs.size()), emission(defs.size() * 4) {
+    for (size_t id = 0; id < defs.size(); id++) {
+        const auto& def = *defs[id];
+        flags[id] = (def.lightPassing ? LIGHT_PASSING : 0) |
+                    (def.skyLightPassing ? SKY_LIGHT_PASSING : 0) |
+                    (def.rt.solid ? SOLID : 0) |
+                    (def.obstacle ? OBSTACLE : 0) |
+                    (def.translucent ? TRANSLUCENT : 0) |
+                    (def.rt.emissive ? EMISSIVE : 0);
+        for (int channel = 0; channel < 4; channel++) {
+            emission[id * 4 + channel] = def.emission[channel];
+        }
+    }
 }
 
 Content::Content(
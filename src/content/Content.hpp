@@ -67,12 +67,66 @@ public:
     }
 };
 
+/// @brief Compact id-indexed tables of block properties read in hot loops
+/// (lighting, meshing, physics). Built once on content load
+class BlockPropertiesTable {
+public:
+    enum Flag : uint8_t {
+        LIGHT_PASSING = 0x1,
+        SKY_LIGHT_PASSING = 0x2,
+        SOLID = 0x4,
+        OBSTACLE = 0x8,
+        TRANSLUCENT = 0x10,
+        EMISSIVE = 0x20,
+    };
+
+    BlockPropertiesTable(const std::vector<Block*>& defs);
+
+    inline bool has(blockid_t id, Flag flag) const {
+        return flags[id] & flag;
+    }
+
+    inline bool isLightPassing(blockid_t id) const {
+        return flags[id] & LIGHT_PASSING;
+    }
+
+    inline bool isSkyLightPassing(blockid_t id) const {
+        return flags[id] & SKY_LIGHT_PASSING;
+    }
+
+    inline bool isSolid(blockid_t id) const {
+        return flags[id] & SOLID;
+    }
+
+    inline bool isObstacle(blockid_t id) const {
+        return flags[id] & OBSTACLE;
+    }
+
+    inline bool isEmissive(blockid_t id) const {
+        return flags[id] & EMISSIVE;
+    }
+
+    /// @param channel light channel index (0-3)
+    inline uint8_t getEmission(blockid_t id, int channel) const {
+        return emission[id * 4 + channel];
+    }
+
+    inline size_t size() const {
+        return flags.size();
+    }
+private:
+    std::vector<uint8_t> flags;
+    /// @brief R, G, B, S emission of each block
+    std::vector<uint8_t> emission;
+};
+
 /// @brief Runtime defs cache: indices
 class ContentIndices {
 public:
     ContentUnitIndices<Block> blocks;
     ContentUnitIndices<ItemDef> items;
     ContentUnitIndices<EntityDef> entities;
+    BlockPropertiesTable blockProperties;
 
     ContentIndices(
         ContentUnitIndices<Block> blocks,
@@ -232,6 +232,7 @@ void Engine::postUpdate() {
     network->update();
     postRunnables.run();
     scripting::process_post_runnables();
+    scripting::update_workers();
 }
 
 void Engine::updateFrontend() {
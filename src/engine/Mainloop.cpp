@@ -2,6 +2,7 @@
 
 #include "Engine.hpp"
 #include "debug/Logger.hpp"
+#include "logic/scripting/scripting.hpp"
 #include "frontend/screens/MenuScreen.hpp"
 #include "frontend/screens/LevelScreen.hpp"
 #include "window/Window.hpp"
@@ -34,12 +35,23 @@ void Mainloop::run() {
     
     logger.info() << "main loop started";
     while (!window.isShouldClose()){
-        time.update(window.time());
+        double frameStart = window.time();
+        time.update(frameStart);
         engine.updateFrontend();
         if (!window.isIconified()) {
             engine.renderFrame();
         }
         engine.postUpdate();
+
+        // a half of the frame limiter idle time is given to Lua
+        // garbage collector
+        int framerate = engine.getSettings().display.framerate.get();
+        int64_t idle = 0;
+        if (framerate > 0) {
+            idle = (1.0 / framerate - (window.time() - frameStart)) * 1e6;
+        }
+        scripting::collect_garbage(idle / 2);
+
         engine.nextFrame();
     }
     logger.info() << "main loop stopped";
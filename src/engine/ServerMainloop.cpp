@@ -8,14 +8,21 @@
 #include "world/Level.hpp"
 #include "world/World.hpp"
 #include "util/platform.hpp"
+#include "util/timeutil.hpp"
 
 #include <chrono>
+#include <algorithm>
 
 using namespace std::chrono;
 
 static debug::Logger logger("mainloop");
 
 inline constexpr int TPS = 20;
+/// @brief Max missed ticks run in one loop iteration, the rest are skipped
+inline constexpr int MAX_CATCH_UP_TICKS = 4;
+/// @brief MSPT/TPS readout update interval (seconds)
+inline constexpr double STATS_INTERVAL = 1.0;
+inline constexpr double LAG_REPORT_INTERVAL = 5.0;
 
 ServerMainloop::ServerMainloop(Engine& engine) : engine(engine) {
 }
@@ -40,9 +47,11 @@ void ServerMainloop::run() {
     );
 
     double targetDelta = 1.0 / static_cast<double>(TPS);
-    double delta = targetDelta;
-    auto begin = system_clock::now();
-    auto startupTime = begin;
+    auto tickDuration = duration_cast<system_clock::duration>(
+        duration<double>(targetDelta)
+    );
+    auto startupTime = system_clock::now();
+    auto nextTick = startupTime;
 
     while (process->isActive()) {
         if (engine.isQuitSignal()) {
@@ -50,34 +59,91 @@ void ServerMainloop::run() {
             logger.info() << "script has been terminated due to quit signal";
             break;
         }
+        int ticks = 1;
         if (coreParams.testMode) {
-            time.step(delta);
+            time.step(targetDelta);
         } else {
             auto now = system_clock::now();
             time.update(
                 duration_cast<microseconds>(now - startupTime).count() / 1e6);
-            delta = time.getDelta();
+
+            int missed = (now - nextTick) / tickDuration;
+            if (missed > MAX_CATCH_UP_TICKS) {
+                skipped += missed - MAX_CATCH_UP_TICKS;
+                nextTick += tickDuration * (missed - MAX_CATCH_UP_TICKS);
+                missed = MAX_CATCH_UP_TICKS;
+            }
+            ticks += std::max(missed, 0);
         }
         process->update();
-        if (controller) {
-            controller->getLevel()->getWorld()->updateTimers(delta);
-            controller->update(glm::min(delta, 0.2), false);
+        for (int i = 0; i < ticks; i++) {
+            // missed ticks are processed with reduced work
+            tick(targetDelta, i + 1 < ticks);
         }
+        caughtUp += ticks - 1;
         engine.postUpdate();
 
-        if (!coreParams.testMode) {
-            auto end = system_clock::now();
-            int64_t millis = targetDelta * 1000 - 
-                duration_cast<microseconds>(end - begin).count() / 1000;
+        if (coreParams.testMode) {
+            scripting::collect_garbage(0);
+            updateStats(targetDelta);
+        } else {
+            nextTick += tickDuration * ticks;
+            auto idle = [&]() {
+                return duration_cast<microseconds>(
+                    nextTick - system_clock::now()
+                ).count();
+            };
+            // a half of the idle time is given to Lua garbage collector
+            scripting::collect_garbage(idle() / 2);
+            int64_t millis = idle() / 1000;
             if (millis > 0) {
                 platform::sleep(millis);
             }
-            begin = system_clock::now();
+            updateStats(time.getDelta());
         }
     }
     logger.info() << "script finished";
 }
 
+void ServerMainloop::tick(double delta, bool reducedWork) {
+    if (controller == nullptr) {
+        return;
+    }
+    timeutil::Timer timer;
+    controller->getLevel()->getWorld()->updateTimers(delta);
+    controller->setReducedWork(reducedWork);
+    controller->update(delta, false);
+    ticksTime += timer.stop();
+    ticksCount++;
+}
+
+void ServerMainloop::updateStats(double elapsed) {
+    statsTimer += elapsed;
+    lagReportTimer += elapsed;
+    if (statsTimer >= STATS_INTERVAL) {
+        double mspt = ticksCount ? ticksTime / 1000.0 / ticksCount : 0.0;
+        double tps = ticksCount / statsTimer;
+        engine.getTime().setTickStats(
+            mspt, std::min(tps, static_cast<double>(TPS))
+        );
+        ticksTime = 0;
+        ticksCount = 0;
+        statsTimer = 0.0;
+    }
+    if (lagReportTimer >= LAG_REPORT_INTERVAL) {
+        if (caughtUp || skipped) {
+            const auto& time = engine.getTime();
+            logger.warning() << "server is lagging: " << time.getTPS()
+                             << " tps, " << time.getMSPT() << " mspt, caught up "
+                             << caughtUp << " ticks, skipped " << skipped
+                             << " ticks";
+        }
+        caughtUp = 0;
+        skipped = 0;
+        lagReportTimer = 0.0;
+    }
+}
+
 void ServerMainloop::setLevel(std::unique_ptr<Level> level) {
     if (level == nullptr) {
         controller->onWorldQuit();
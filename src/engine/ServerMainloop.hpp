@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <cstdint>
 
 class Level;
 class LevelController;
@@ -9,6 +10,19 @@ class Engine;
 class ServerMainloop {
     Engine& engine;
     std::unique_ptr<LevelController> controller;
+
+    /// @brief Ticks work time (microseconds) since the last stats update
+    int64_t ticksTime = 0;
+    int ticksCount = 0;
+    double statsTimer = 0.0;
+    /// @brief Catch-up ticks and skipped ticks since the last lag report
+    int caughtUp = 0;
+    int skipped = 0;
+    double lagReportTimer = 0.0;
+
+    void tick(double delta, bool reducedWork);
+    /// @brief Update MSPT/TPS readout, report lag to log
+    void updateStats(double elapsed);
 public:
     ServerMainloop(Engine& engine);
     ~ServerMainloop();
@@ -6,6 +6,8 @@ class Time {
     uint64_t frame = 0;
     double lastTime = 0.0;
     double delta = 0.0;
+    double mspt = 0.0;
+    double tps = 0.0;
 public:
     Time() {}
 
@@ -32,4 +34,19 @@ public:
     double getTime() const {
         return lastTime;
     }
+
+    /// @param mspt average milliseconds spent per tick
+    /// @param tps ticks per second processed
+    void setTickStats(double mspt, double tps) {
+        this->mspt = mspt;
+        this->tps = tps;
+    }
+
+    double getMSPT() const {
+        return mspt;
+    }
+
+    double getTPS() const {
+        return tps;
+    }
 };
@@ -10,6 +10,7 @@ class Texture;
 class Batch2D;
 class Batch3D;
 class Camera;
+class GlyphQuadsCache;
 
 struct FontStyle {
     bool bold = false;
@@ -33,6 +34,12 @@ struct FontStyle {
           underline(underline),
           color(std::move(color)) {
     }
+
+    bool operator==(const FontStyle& other) const {
+        return bold == other.bold && italic == other.italic &&
+               strikethrough == other.strikethrough &&
+               underline == other.underline && color == other.color;
+    }
 };
 
 struct FontStylesScheme {
@@ -45,6 +52,8 @@ class Font {
     int yoffset;
     int glyphInterval = 8;
     std::vector<std::unique_ptr<Texture>> pages;
+    /// @brief Drawn texts glyph quads
+    std::unique_ptr<GlyphQuadsCache> quadsCache;
 public:
     Font(std::vector<std::unique_ptr<Texture>> pages, int lineHeight, int yoffset);
     ~Font();
@@ -89,5 +98,7 @@ public:
         const glm::vec3& up={0, 1, 0}
     ) const;
 
+    GlyphQuadsCache& getQuadsCache() const;
+
     const Texture* getPage(int page) const;
 };
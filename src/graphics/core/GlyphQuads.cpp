@@ -0,0 +1,179 @@
+#include "GlyphQuads.hpp"
+
+#include <algorithm>
+#include <functional>
+
+inline constexpr uint MAX_CODEPAGES = 10000; // idk ho many codepages unicode has
+
+bool is_printable_char(uint codepoint) {
+    switch (codepoint){
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\f':
+        case '\r':
+            return false;
+        default:
+            return true;
+    }
+}
+
+static inline ubyte style_at(
+    const FontStylesScheme& styles, size_t index
+) {
+    return styles.map.at(std::min(styles.map.size() - 1, index));
+}
+
+static inline void add_glyph(
+    std::vector<GlyphQuad>& dst,
+    const glm::vec2& offset,
+    uint c,
+    const FontStyle& style
+) {
+    for (int i = 0; i <= style.bold; i++) {
+        dst.push_back(GlyphQuad {offset, c, i, style.italic, style.color});
+    }
+}
+
+void build_glyph_quads(
+    std::vector<GlyphQuad>& dst,
+    std::wstring_view text,
+    const FontStylesScheme* styles,
+    size_t styleMapOffset
+) {
+    static FontStylesScheme defStyles {{{}}, {0}};
+
+    if (styles == nullptr) {
+        styles = &defStyles;
+    }
+
+    uint page = 0;
+    uint next = MAX_CODEPAGES;
+    int x = 0;
+    int y = 0;
+    bool hasLines = false;
+
+    do {
+        for (size_t i = 0; i < text.length(); i++) {
+            uint c = text[i];
+            const FontStyle& style =
+                styles->palette.at(style_at(*styles, i + styleMapOffset));
+            hasLines |= style.strikethrough;
+            hasLines |= style.underline;
+
+            if (!is_printable_char(c)) {
+                x++;
+                continue;
+            }
+            uint charpage = c >> 8;
+            if (charpage == page){
+                add_glyph(dst, glm::vec2(x, y), c, style);
+            }
+            else if (charpage > page && charpage < next){
+                next = charpage;
+            }
+            x++;
+        }
+        page = next;
+        next = MAX_CODEPAGES;
+        x = 0;
+    } while (page < MAX_CODEPAGES);
+
+    if (!hasLines) {
+        return;
+    }
+    for (size_t i = 0; i < text.length(); i++) {
+        const FontStyle& style =
+            styles->palette.at(style_at(*styles, i + styleMapOffset));
+        FontStyle lineStyle = style;
+        lineStyle.bold = true;
+        if (style.strikethrough) {
+            add_glyph(dst, glm::vec2(x, y), '-', lineStyle);
+        }
+        if (style.underline) {
+            add_glyph(dst, glm::vec2(x, y), '_', lineStyle);
+        }
+        x++;
+    }
+}
+
+GlyphQuadsCache::GlyphQuadsCache(size_t capacity) : capacity(capacity) {
+}
+
+bool GlyphQuadsCache::matches(
+    const Entry& entry,
+    std::wstring_view text,
+    const FontStylesScheme* styles,
+    size_t styleMapOffset
+) {
+    if (entry.text != text || entry.styled != (styles != nullptr)) {
+        return false;
+    }
+    if (styles == nullptr) {
+        return true;
+    }
+    if (entry.palette != styles->palette) {
+        return false;
+    }
+    for (size_t i = 0; i < text.length(); i++) {
+        if (entry.map[i] != style_at(*styles, i + styleMapOffset)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::vector<GlyphQuad>& GlyphQuadsCache::get(
+    std::wstring_view text,
+    const FontStylesScheme* styles,
+    size_t styleMapOffset
+) {
+    size_t hash = std::hash<std::wstring_view>()(text);
+    const auto& found = index.find(hash);
+    if (found != index.end()) {
+        auto entry = found->second;
+        entries.splice(entries.begin(), entries, entry);
+        if (matches(*entry, text, styles, styleMapOffset)) {
+            stats.hits++;
+            return entry->quads;
+        }
+    } else {
+        if (entries.size() >= capacity) {
+            index.erase(std::hash<std::wstring_view>()(entries.back().text));
+            entries.pop_back();
+        }
+        entries.emplace_front();
+        index[hash] = entries.begin();
+    }
+    stats.misses++;
+
+    // entry is the first one now
+    auto& entry = entries.front();
+    entry.text = text;
+    entry.styled = styles != nullptr;
+    entry.palette.clear();
+    entry.map.clear();
+    if (styles) {
+        entry.palette = styles->palette;
+        entry.map.resize(text.length());
+        for (size_t i = 0; i < text.length(); i++) {
+            entry.map[i] = style_at(*styles, i + styleMapOffset);
+        }
+    }
+    entry.quads.clear();
+    build_glyph_quads(entry.quads, text, styles, styleMapOffset);
+    return entry.quads;
+}
+
+void GlyphQuadsCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+size_t GlyphQuadsCache::size() const {
+    return entries.size();
+}
+
+const GlyphQuadsCacheStats& GlyphQuadsCache::getStats() const {
+    return stats;
+}
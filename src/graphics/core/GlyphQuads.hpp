@@ -0,0 +1,90 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "typedefs.hpp"
+#include "Font.hpp"
+
+/// @brief Single glyph sprite of a text in font glyphs grid space.
+/// Independent of text position and scale
+struct GlyphQuad {
+    /// @brief Glyph position in glyphs grid
+    glm::vec2 offset;
+    /// @brief Glyph codepoint, codepage is codepoint >> 8
+    uint codepoint;
+    /// @brief Bold pass index. Bold glyphs are drawn twice with a shift
+    int boldPass;
+    bool italic;
+    glm::vec4 color;
+};
+
+/// @brief Check if character is visible (non-whitespace)
+/// @param codepoint character unicode codepoint
+bool is_printable_char(uint codepoint);
+
+/// @brief Generate text glyph quads in draw order: by codepage, then
+/// decoration lines (strikethrough and underline)
+/// @param text source text
+/// @param styles text styles or nullptr
+/// @param styleMapOffset offset of the text in the styles map
+void build_glyph_quads(
+    std::vector<GlyphQuad>& dst,
+    std::wstring_view text,
+    const FontStylesScheme* styles,
+    size_t styleMapOffset
+);
+
+struct GlyphQuadsCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+/// @brief LRU cache of texts glyph quads. Texts drawn every frame with the
+/// same styles (labels, text notes, debug panel) are generated once
+class GlyphQuadsCache {
+    struct Entry {
+        std::wstring text;
+        bool styled;
+        std::vector<FontStyle> palette;
+        /// @brief Styles map part applied to the text
+        std::vector<ubyte> map;
+        std::vector<GlyphQuad> quads;
+    };
+    size_t capacity;
+    /// @brief Entries ordered from the most recently used
+    std::list<Entry> entries;
+    /// @brief Entries by text hash
+    std::unordered_map<size_t, std::list<Entry>::iterator> index;
+    GlyphQuadsCacheStats stats;
+
+    static bool matches(
+        const Entry& entry,
+        std::wstring_view text,
+        const FontStylesScheme* styles,
+        size_t styleMapOffset
+    );
+public:
+    GlyphQuadsCache(size_t capacity = 512);
+
+    /// @brief Get text glyph quads, generated on cache miss
+    /// @param text source text
+    /// @param styles text styles or nullptr
+    /// @param styleMapOffset offset of the text in the styles map
+    /// @return glyph quads valid until the next get call
+    const std::vector<GlyphQuad>& get(
+        std::wstring_view text,
+        const FontStylesScheme* styles,
+        size_t styleMapOffset
+    );
+
+    void clear();
+
+    size_t size() const;
+
+    const GlyphQuadsCacheStats& getStats() const;
+};
@@ -1,5 +1,7 @@
 #include "BlocksRenderer.hpp"
 
+#include <algorithm>
+
 #include "graphics/core/Mesh.hpp"
 #include "graphics/commons/Model.hpp"
 #include "maths/UVRegion.hpp"
@@ -33,6 +35,9 @@ BlocksRenderer::BlocksRenderer(
         CHUNK_H,
         CHUNK_D + voxelBufferPadding*2);
     blockDefsCache = content.getIndices()->blocks.getDefs();
+    culling = std::make_unique<FacesCulling>(
+        *content.getIndices(), *voxelsBuffer, voxelBufferPadding
+    );
 }
 
 BlocksRenderer::~BlocksRenderer() {
@@ -385,41 +390,41 @@ void BlocksRenderer::blockCube(
     }
 
     if (ao) {
-        if (isOpen(coord + Z, block, variant)) {
+        if (isFaceOpen(coord, Z, block, variant)) {
             faceAO(coord, X, Y, Z, texfaces[5], lights);
         }
-        if (isOpen(coord - Z, block, variant)) {
+        if (isFaceOpen(coord, -Z, block, variant)) {
             faceAO(coord, -X, Y, -Z, texfaces[4], lights);
         }
-        if (isOpen(coord + Y, block, variant)) {
+        if (isFaceOpen(coord, Y, block, variant)) {
             faceAO(coord, X, -Z, Y, texfaces[3], lights);
         }
-        if (isOpen(coord - Y, block, variant)) {
+        if (isFaceOpen(coord, -Y, block, variant)) {
             faceAO(coord, X, Z, -Y, texfaces[2], lights);
         }
-        if (isOpen(coord + X, block, variant)) {
+        if (isFaceOpen(coord, X, block, variant)) {
             faceAO(coord, -Z, Y, X, texfaces[1], lights);
         }
-        if (isOpen(coord - X, block, variant)) {
+        if (isFaceOpen(coord, -X, block, variant)) {
             faceAO(coord, Z, Y, -X, texfaces[0], lights);
         }
     } else {
-        if (isOpen(coord + Z, block, variant)) {
+        if (isFaceOpen(coord, Z, block, variant)) {
             face(coord, X, Y, Z, texfaces[5], pickLight(coord + Z), lights);
         }
-        if (isOpen(coord - Z, block, variant)) {
+        if (isFaceOpen(coord, -Z, block, variant)) {
             face(coord, -X, Y, -Z, texfaces[4], pickLight(coord - Z), lights);
         }
-        if (isOpen(coord + Y, block, variant)) {
+        if (isFaceOpen(coord, Y, block, variant)) {
             face(coord, X, -Z, Y, texfaces[3], pickLight(coord + Y), lights);
         }
-        if (isOpen(coord - Y, block, variant)) {
+        if (isFaceOpen(coord, -Y, block, variant)) {
             face(coord, X, Z, -Y, texfaces[2], pickLight(coord - Y), lights);
         }
-        if (isOpen(coord + X, block, variant)) {
+        if (isFaceOpen(coord, X, block, variant)) {
             face(coord, -Z, Y, X, texfaces[1], pickLight(coord + X), lights);
         }
-        if (isOpen(coord - X, block, variant)) {
+        if (isFaceOpen(coord, -X, block, variant)) {
             face(coord, Z, Y, -X, texfaces[0], pickLight(coord - X), lights);
         }
     }
@@ -432,11 +437,7 @@ bool BlocksRenderer::isOpenForLight(int x, int y, int z) const {
     if (id == BLOCK_VOID) {
         return false;
     }
-    const Block& block = *blockDefsCache[id];
-    if (block.lightPassing) {
-        return true;
-    }
-    return !id;
+    return !id || content.getIndices()->blockProperties.isLightPassing(id);
 }
 
 glm::vec4 BlocksRenderer::pickLight(int x, int y, int z) const {
@@ -705,6 +706,7 @@ void BlocksRenderer::build(const Chunk* chunk, const Chunks* chunks) {
         }
         beginEnds[variant.drawGroup][1] = i;
     }
+    culling->build(chunk->bottom, chunk->top);
     cancelled = false;
 
     overflow = false;
@@ -776,5 +778,7 @@ VoxelsVolume* BlocksRenderer::getVoxelsBuffer() const {
 
 size_t BlocksRenderer::getMemoryConsumption() const {
     size_t volume = voxelsBuffer->getW() * voxelsBuffer->getH() * voxelsBuffer->getD();
-    return capacity * (sizeof(ChunkVertex) + sizeof(uint32_t) * 2) + volume * (sizeof(voxel) + sizeof(light_t));
+    return capacity * (sizeof(ChunkVertex) + sizeof(uint32_t) * 2) +
+           volume * (sizeof(voxel) + sizeof(light_t) + sizeof(uint8_t) * 2) +
+           CHUNK_VOL * sizeof(uint8_t) * 2;
 }
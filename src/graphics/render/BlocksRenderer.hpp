@@ -11,6 +11,7 @@
 #include "maths/util.hpp"
 #include "commons.hpp"
 #include "settings.hpp"
+#include "FacesCulling.hpp"
 
 template<typename VertexStructure> class Mesh;
 class Content;
@@ -41,6 +42,7 @@ class BlocksRenderer {
     std::unique_ptr<VoxelsVolume> voxelsBuffer;
 
     const Block* const* blockDefsCache;
+    std::unique_ptr<FacesCulling> culling;
     const ContentGfxCache& cache;
     const EngineSettings& settings;
     
@@ -125,29 +127,19 @@ class BlocksRenderer {
 
     bool isOpenForLight(int x, int y, int z) const;
 
+    /// @brief Check the direct neighbour face using culling masks
+    inline bool isFaceOpen(
+        const glm::ivec3& coord,
+        const glm::ivec3& dir,
+        const Block& def,
+        const Variant& variant
+    ) const {
+        return culling->isFaceOpen(coord, dir, def, variant, densePass);
+    }
+
     // Does block allow to see other blocks sides (is it transparent)
     inline bool isOpen(const glm::ivec3& pos, const Block& def, const Variant& variant) const {
-        auto vox = voxelsBuffer->pickBlock(
-            chunk->x * CHUNK_W + pos.x, pos.y, chunk->z * CHUNK_D + pos.z
-        );
-        if (vox.id == BLOCK_VOID) {
-            return false;
-        }
-        const auto& block = *blockDefsCache[vox.id];
-        const auto& blockVariant = block.getVariantByBits(vox.state.userbits);
-        uint8_t otherDrawGroup = blockVariant.drawGroup;
-        if ((otherDrawGroup && (otherDrawGroup != variant.drawGroup)) || !blockVariant.rt.solid) {
-            return true;
-        }
-        if (densePass) {
-            return variant.culling == CullingMode::OPTIONAL;
-        } else if (variant.culling == CullingMode::OPTIONAL) {
-            return false;
-        }
-        if (variant.culling == CullingMode::DISABLED && vox.id == def.rt.id) {
-            return true;
-        }
-        return !vox.id;
+        return culling->isOpen(pos, def, variant, densePass);
     }
 
     glm::vec4 pickLight(int x, int y, int z) const;
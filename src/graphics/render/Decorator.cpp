@@ -110,7 +110,12 @@ void Decorator::updateRandom(
     if (!def.obstacle || dst2 >= 256 || weather.fall.noise.empty()) {
         return;
     }
-    for (int y = pos.y + 1; y < chunk->top; y++) {
+    int top = chunk->heights.get(
+        HeightmapType::NON_AIR,
+        pos.x - chunk->x * CHUNK_W,
+        pos.z - chunk->z * CHUNK_D
+    );
+    for (int y = pos.y + 1; y <= top; y++) {
         if (indices.blocks.require(chunks.get(pos.x, y, pos.z)->id).obstacle) {
             return;
         }
@@ -234,6 +239,7 @@ void Decorator::updateTextNotes() {
                 position = entity->getInterpolatedPosition();
             }
             note->setPosition(position + glm::vec3(0, 1, 0));
+            renderer.texts->update(textsIter->second);
             ++textsIter;
         }
     }
@@ -0,0 +1,102 @@
+#include "FacesCulling.hpp"
+
+#include <algorithm>
+
+#include "constants.hpp"
+#include "content/Content.hpp"
+
+inline constexpr uint8_t OCCLUSION_VOID = 0x1;
+inline constexpr uint8_t OCCLUSION_SOLID = 0x2;
+/// @brief Block has variants, so properties depend on user bits
+inline constexpr uint8_t OCCLUSION_VARIANTS = 0x4;
+
+FacesCulling::FacesCulling(
+    const ContentIndices& indices,
+    const VoxelsVolume& voxelsBuffer,
+    int padding
+)
+    : blockDefs(indices.blocks.getDefs()),
+      voxelsBuffer(voxelsBuffer),
+      padding(padding) {
+    size_t blocksCount = indices.blocks.count();
+    blockGroups = std::make_unique<uint8_t[]>(blocksCount);
+    blockFlags = std::make_unique<uint8_t[]>(blocksCount);
+    for (size_t id = 0; id < blocksCount; id++) {
+        const auto& def = *blockDefs[id];
+        blockGroups[id] = def.defaults.drawGroup;
+        blockFlags[id] = (def.defaults.rt.solid ? OCCLUSION_SOLID : 0) |
+                         (def.variants ? OCCLUSION_VARIANTS : 0);
+    }
+    size_t volume = voxelsBuffer.getW() * voxelsBuffer.getH() *
+                    voxelsBuffer.getD();
+    voxelGroups = std::make_unique<uint8_t[]>(volume);
+    voxelFlags = std::make_unique<uint8_t[]>(volume);
+    closedFaces = std::make_unique<uint8_t[]>(CHUNK_VOL);
+    voidFaces = std::make_unique<uint8_t[]>(CHUNK_VOL);
+}
+
+FacesCulling::~FacesCulling() = default;
+
+void FacesCulling::build(int bottom, int top) {
+    const int w = voxelsBuffer.getW();
+    const int d = voxelsBuffer.getD();
+    const int pad = padding;
+    const voxel* voxels = voxelsBuffer.getVoxels();
+
+    // occlusion properties of the chunk voxels and their direct neighbours
+    int minY = std::max(bottom - 1, 0);
+    int maxY = std::min(top + 1, CHUNK_H);
+    for (int y = minY; y < maxY; y++) {
+        for (int z = pad - 1; z <= pad + CHUNK_D; z++) {
+            for (int x = pad - 1; x <= pad + CHUNK_W; x++) {
+                uint index = vox_index(x, y, z, w, d);
+                const voxel& vox = voxels[index];
+                if (vox.id == BLOCK_VOID) {
+                    voxelGroups[index] = 0;
+                    voxelFlags[index] = OCCLUSION_VOID;
+                    continue;
+                }
+                uint8_t flags = blockFlags[vox.id];
+                if (flags & OCCLUSION_VARIANTS) {
+                    const auto& variant = blockDefs[vox.id]
+                        ->getVariantByBits(vox.state.userbits);
+                    voxelGroups[index] = variant.drawGroup;
+                    voxelFlags[index] = variant.rt.solid ? OCCLUSION_SOLID : 0;
+                } else {
+                    voxelGroups[index] = blockGroups[vox.id];
+                    voxelFlags[index] = flags;
+                }
+            }
+        }
+    }
+
+    // neighbour offsets in FACE_* order
+    const int offsets[6] {-1, 1, -w * d, w * d, -w, w};
+    for (int y = bottom; y < top; y++) {
+        uint8_t outside = (y == 0 ? 1 << FACE_MY : 0) |
+                          (y + 1 == CHUNK_H ? 1 << FACE_PY : 0);
+        for (int z = 0; z < CHUNK_D; z++) {
+            for (int x = 0; x < CHUNK_W; x++) {
+                int index = vox_index(x + pad, y, z + pad, w, d);
+                uint8_t group = voxelGroups[index];
+                uint8_t closed = 0;
+                uint8_t voids = outside;
+                for (int face = 0; face < 6; face++) {
+                    if (outside & (1 << face)) {
+                        continue;
+                    }
+                    int neighbour = index + offsets[face];
+                    uint8_t flags = voxelFlags[neighbour];
+                    uint8_t otherGroup = voxelGroups[neighbour];
+                    voids |= ((flags & OCCLUSION_VOID) != 0) << face;
+                    closed |= ((flags & OCCLUSION_SOLID) &&
+                               (otherGroup == 0 || otherGroup == group))
+                              << face;
+                }
+                uint chunkIndex = vox_index(x, y, z);
+                closedFaces[chunkIndex] = closed;
+                voidFaces[chunkIndex] = voids;
+            }
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <memory>
+#include <glm/glm.hpp>
+
+#include "typedefs.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/VoxelsVolume.hpp"
+
+class ContentIndices;
+
+/// @brief Chunk voxels faces culling. Uses precomputed faces masks for
+/// direct neighbours of the chunk voxels (see build)
+class FacesCulling {
+    const Block* const* blockDefs;
+    const VoxelsVolume& voxelsBuffer;
+    /// @brief Voxels buffer padding around the chunk
+    int padding;
+    /// @brief Per-id draw groups and occlusion flags lookup tables
+    std::unique_ptr<uint8_t[]> blockGroups;
+    std::unique_ptr<uint8_t[]> blockFlags;
+    /// @brief Voxels buffer draw groups and occlusion flags (filled by build)
+    std::unique_ptr<uint8_t[]> voxelGroups;
+    std::unique_ptr<uint8_t[]> voxelFlags;
+    /// @brief Chunk voxels faces covered by solid neighbours of a compatible
+    /// draw group (6-bit masks indexed by FACE_* constants)
+    std::unique_ptr<uint8_t[]> closedFaces;
+    /// @brief Chunk voxels faces adjacent to void (missing chunk or out of
+    /// height range)
+    std::unique_ptr<uint8_t[]> voidFaces;
+
+    static inline uint faceIndex(const glm::ivec3& dir) {
+        if (dir.x) {
+            return dir.x > 0 ? FACE_PX : FACE_MX;
+        } else if (dir.y) {
+            return dir.y > 0 ? FACE_PY : FACE_MY;
+        }
+        return dir.z > 0 ? FACE_PZ : FACE_MZ;
+    }
+public:
+    /// @param voxelsBuffer chunk voxels with neighbours, positioned at
+    /// the chunk position minus padding
+    FacesCulling(
+        const ContentIndices& indices,
+        const VoxelsVolume& voxelsBuffer,
+        int padding
+    );
+    ~FacesCulling();
+
+    /// @brief Build chunk voxels faces masks used instead of isOpen
+    /// for direct neighbours
+    /// @param bottom chunk voxels range bottom (inclusive)
+    /// @param top chunk voxels range top (exclusive)
+    void build(int bottom, int top);
+
+    /// @brief isOpen equivalent for the direct neighbour of a chunk voxel
+    /// using precomputed faces masks
+    inline bool isFaceOpen(
+        const glm::ivec3& coord,
+        const glm::ivec3& dir,
+        const Block& def,
+        const Variant& variant,
+        bool densePass
+    ) const {
+        uint index = vox_index(coord.x, coord.y, coord.z);
+        uint8_t bit = 1 << faceIndex(dir);
+        if (voidFaces[index] & bit) {
+            return false;
+        }
+        if (!(closedFaces[index] & bit)) {
+            return true;
+        }
+        if (densePass) {
+            return variant.culling == CullingMode::OPTIONAL;
+        } else if (variant.culling == CullingMode::DISABLED) {
+            // depends on neighbour id
+            return isOpen(coord + dir, def, variant, densePass);
+        }
+        return false;
+    }
+
+    /// @brief Does block allow to see other blocks sides (is it transparent)
+    /// @param pos position relative to the chunk
+    inline bool isOpen(
+        const glm::ivec3& pos,
+        const Block& def,
+        const Variant& variant,
+        bool densePass
+    ) const {
+        auto vox = voxelsBuffer.pickBlock(
+            voxelsBuffer.getX() + padding + pos.x,
+            pos.y,
+            voxelsBuffer.getZ() + padding + pos.z
+        );
+        if (vox.id == BLOCK_VOID) {
+            return false;
+        }
+        const auto& block = *blockDefs[vox.id];
+        const auto& blockVariant = block.getVariantByBits(vox.state.userbits);
+        uint8_t otherDrawGroup = blockVariant.drawGroup;
+        if ((otherDrawGroup && (otherDrawGroup != variant.drawGroup)) ||
+            !blockVariant.rt.solid) {
+            return true;
+        }
+        if (densePass) {
+            return variant.culling == CullingMode::OPTIONAL;
+        } else if (variant.culling == CullingMode::OPTIONAL) {
+            return false;
+        }
+        if (variant.culling == CullingMode::DISABLED && vox.id == def.rt.id) {
+            return true;
+        }
+        return !vox.id;
+    }
+};
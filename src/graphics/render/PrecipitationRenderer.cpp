@@ -1,5 +1,7 @@
 #include "PrecipitationRenderer.hpp"
 
+#include <algorithm>
+
 #include "MainBatch.hpp"
 #include "assets/Assets.hpp"
 #include "assets/assets_util.hpp"
@@ -37,18 +39,9 @@ int PrecipitationRenderer::getHeightAt(int x, int z) {
     if (chunk == nullptr) {
         return y;
     }
-    y = chunk->top;
     x -= cx * CHUNK_W;
     z -= cz * CHUNK_D;
-    while (y > 0) {
-        const auto& vox = chunk->voxels[vox_index(x, y, z)];
-        if (vox.id == 0) {
-            y--;
-            continue;
-        }
-        break;
-    }
-    return y;
+    return std::max(0, chunk->heights.get(HeightmapType::NON_AIR, x, z));
 }
 
 static inline glm::vec4 light_at(const Chunks& chunks, int x, int y, int z) {
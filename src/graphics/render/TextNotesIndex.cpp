@@ -0,0 +1,112 @@
+#include "TextNotesIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "constants.hpp"
+#include "maths/FrustumCulling.hpp"
+#include "maths/util.hpp"
+
+static glm::ivec2 bucket_of(const glm::vec3& position) {
+    return glm::ivec2(
+        std::floor(position.x / CHUNK_W), std::floor(position.z / CHUNK_D)
+    );
+}
+
+void TextNotesIndex::refreshBucket(Bucket& bucket) const {
+    bucket.posMin = glm::vec3(INFINITY);
+    bucket.posMax = glm::vec3(-INFINITY);
+    bucket.boundsMin = glm::vec3(INFINITY);
+    bucket.boundsMax = glm::vec3(-INFINITY);
+    bucket.renderDistance = 0.0f;
+    bucket.unbounded = false;
+    for (u64id_t id : bucket.notes) {
+        const auto& bounds = entries.at(id).bounds;
+        bucket.posMin = glm::min(bucket.posMin, bounds.position);
+        bucket.posMax = glm::max(bucket.posMax, bounds.position);
+        bucket.boundsMin =
+            glm::min(bucket.boundsMin, bounds.position - bounds.radius);
+        bucket.boundsMax =
+            glm::max(bucket.boundsMax, bounds.position + bounds.radius);
+        bucket.renderDistance =
+            std::max(bucket.renderDistance, bounds.renderDistance);
+        bucket.unbounded |= bounds.radius < 0.0f;
+    }
+}
+
+void TextNotesIndex::removeFromBucket(u64id_t id, const glm::ivec2& key) {
+    const auto& found = buckets.find(key);
+    if (found == buckets.end()) {
+        return;
+    }
+    auto& bucket = found->second;
+    auto& notes = bucket.notes;
+    notes.erase(std::remove(notes.begin(), notes.end(), id), notes.end());
+    if (notes.empty()) {
+        buckets.erase(found);
+    } else {
+        refreshBucket(bucket);
+    }
+}
+
+void TextNotesIndex::set(u64id_t id, const TextNoteBounds& bounds) {
+    auto key = bucket_of(bounds.position);
+    const auto& found = entries.find(id);
+    if (found != entries.end()) {
+        auto& entry = found->second;
+        if (entry.bounds == bounds) {
+            return;
+        }
+        auto prevKey = entry.bucket;
+        entry = Entry {key, bounds};
+        if (prevKey == key) {
+            refreshBucket(buckets.at(key));
+            return;
+        }
+        removeFromBucket(id, prevKey);
+    } else {
+        entries[id] = Entry {key, bounds};
+    }
+    auto& bucket = buckets[key];
+    bucket.notes.push_back(id);
+    refreshBucket(bucket);
+}
+
+void TextNotesIndex::remove(u64id_t id) {
+    const auto& found = entries.find(id);
+    if (found == entries.end()) {
+        return;
+    }
+    auto key = found->second.bucket;
+    entries.erase(found);
+    removeFromBucket(id, key);
+}
+
+void TextNotesIndex::query(
+    std::vector<u64id_t>& dst,
+    const glm::vec3& position,
+    float zoom,
+    const Frustum& frustum
+) const {
+    dst.clear();
+    for (const auto& [_, bucket] : buckets) {
+        glm::vec3 nearest = glm::clamp(position, bucket.posMin, bucket.posMax);
+        if (util::distance2(nearest, position) >
+            util::sqr(bucket.renderDistance / zoom)) {
+            continue;
+        }
+        if (!bucket.unbounded &&
+            !frustum.isBoxVisible(bucket.boundsMin, bucket.boundsMax)) {
+            continue;
+        }
+        dst.insert(dst.end(), bucket.notes.begin(), bucket.notes.end());
+    }
+}
+
+size_t TextNotesIndex::size() const {
+    return entries.size();
+}
+
+size_t TextNotesIndex::countBuckets() const {
+    return buckets.size();
+}
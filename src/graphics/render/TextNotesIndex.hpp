@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#include "typedefs.hpp"
+
+class Frustum;
+
+/// @brief Text note bounds used by TextNotesIndex
+struct TextNoteBounds {
+    glm::vec3 position;
+    /// @brief Max distance from camera the note is rendered at (zoom 1)
+    float renderDistance;
+    /// @brief Radius of sphere around position containing the note text or
+    /// negative if the note shape depends on view (billboards, projected)
+    float radius;
+
+    bool operator==(const TextNoteBounds& other) const {
+        return position == other.position &&
+               renderDistance == other.renderDistance &&
+               radius == other.radius;
+    }
+};
+
+/// @brief Chunk-bucketed spatial index of text notes. Buckets out of
+/// render distance or frustum are skipped before per-note checks
+class TextNotesIndex {
+    struct Bucket {
+        std::vector<u64id_t> notes;
+        /// @brief Notes positions bounding box
+        glm::vec3 posMin;
+        glm::vec3 posMax;
+        /// @brief Notes texts bounding box
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        float renderDistance;
+        /// @brief Bucket contains notes with view dependent shape
+        bool unbounded;
+    };
+    struct Entry {
+        glm::ivec2 bucket;
+        TextNoteBounds bounds;
+    };
+    std::unordered_map<glm::ivec2, Bucket> buckets;
+    std::unordered_map<u64id_t, Entry> entries;
+
+    void refreshBucket(Bucket& bucket) const;
+    void removeFromBucket(u64id_t id, const glm::ivec2& key);
+public:
+    /// @brief Add note or update its bounds
+    void set(u64id_t id, const TextNoteBounds& bounds);
+
+    void remove(u64id_t id);
+
+    /// @brief Collect notes which may be visible from the camera
+    /// @param dst destination vector (cleared)
+    /// @param position camera position
+    /// @param zoom camera zoom (render distance is divided by it)
+    /// @param frustum camera frustum
+    void query(
+        std::vector<u64id_t>& dst,
+        const glm::vec3& position,
+        float zoom,
+        const Frustum& frustum
+    ) const;
+
+    size_t size() const;
+
+    size_t countBuckets() const;
+};
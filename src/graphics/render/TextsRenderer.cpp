@@ -126,19 +126,40 @@ void TextsRenderer::render(
     shader.uniformMatrix("u_projview", camera.getProjView());
     shader.uniformMatrix("u_apply", glm::mat4(1.0f));
     batch.begin();
-    for (const auto& [_, note] : notes) {
-        renderNote(*note, context, camera, settings, hudVisible, frontLayer, false);
+    index.query(visibleNotes, camera.position, camera.zoom, frustum);
+    for (u64id_t id : visibleNotes) {
+        const auto& note = *notes.at(id);
+        renderNote(note, context, camera, settings, hudVisible, frontLayer, false);
     }
     batch.flush();
     shader.uniformMatrix("u_projview", glm::mat4(1.0f));
-    for (const auto& [_, note] : notes) {
-        renderNote(*note, context, camera, settings, hudVisible, frontLayer, true);
+    for (u64id_t id : visibleNotes) {
+        const auto& note = *notes.at(id);
+        renderNote(note, context, camera, settings, hudVisible, frontLayer, true);
     }
     batch.flush();
 }
 
+TextNoteBounds TextsRenderer::calcBounds(const TextNote& note) const {
+    const auto& preset = note.getPreset();
+    float radius = -1.0f;
+    if (preset.displayMode == NoteDisplayMode::STATIC_BILLBOARD) {
+        const auto& font = assets.require<Font>(FONT_DEFAULT);
+        const auto& text = note.getText();
+        float width = font.calcWidth(text, text.length());
+        float height = font.getLineHeight();
+        radius = (width * 0.5f * glm::length(note.getAxisX()) +
+                  height * glm::length(note.getAxisY())) *
+                 preset.scale;
+    }
+    return TextNoteBounds {
+        note.getPosition(), preset.renderDistance, radius
+    };
+}
+
 u64id_t TextsRenderer::add(std::unique_ptr<TextNote> note) {
     u64id_t uid = nextNote++;
+    index.set(uid, calcBounds(*note));
     notes[uid] = std::move(note);
     return uid;
 }
@@ -151,6 +172,13 @@ TextNote* TextsRenderer::get(u64id_t id) const {
     return found->second.get();
 }
 
+void TextsRenderer::update(u64id_t id) {
+    if (auto note = get(id)) {
+        index.set(id, calcBounds(*note));
+    }
+}
+
 void TextsRenderer::remove(u64id_t id) {
+    index.remove(id);
     notes.erase(id);
 }
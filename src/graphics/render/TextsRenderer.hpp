@@ -2,8 +2,10 @@
 
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include "typedefs.hpp"
+#include "TextNotesIndex.hpp"
 
 class DrawContext;
 class Camera;
@@ -20,6 +22,11 @@ class TextsRenderer {
 
     std::unordered_map<u64id_t, std::unique_ptr<TextNote>> notes;
     u64id_t nextNote = 1;
+    TextNotesIndex index;
+    /// @brief Notes passed index query in the current frame
+    std::vector<u64id_t> visibleNotes;
+
+    TextNoteBounds calcBounds(const TextNote& note) const;
 
     void renderNote(
         const TextNote& note,
@@ -45,5 +52,9 @@ public:
 
     TextNote* get(u64id_t id) const;
 
+    /// @brief Refresh note in the spatial index. Must be called after note
+    /// text, position, axes or preset change
+    void update(u64id_t id);
+
     void remove(u64id_t id);
 };
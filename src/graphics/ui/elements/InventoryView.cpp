@@ -364,6 +364,8 @@ void SlotView::clicked(Mousecode button) {
     } else if (button == Mousecode::BUTTON_2) {
         performRightClick(stack, grabbed);
     }
+    // the bound stack is modified bypassing the inventory
+    inventory->setDirty();
     if (layout.updateFunc) {
         layout.updateFunc(layout.index, stack);
     }
@@ -382,11 +384,12 @@ const std::wstring& SlotView::getTooltip() const {
 }
 
 void SlotView::bind(
-    int64_t inventoryid,
+    Inventory& inventory,
     ItemStack& stack, 
     const Content* content
 ) {
-    this->inventoryid = inventoryid;
+    this->inventoryid = inventory.getId();
+    this->inventory = &inventory;
     bound = &stack;
     this->content = content;
 }
@@ -445,7 +448,7 @@ void InventoryView::bind(
     this->content = content;
     for (auto slot : slots) {
         slot->bind(
-            inventory->getId(),
+            *inventory,
             inventory->getSlot(slot->getLayout().index),
             content
         );
@@ -62,6 +62,7 @@ namespace gui {
         bool highlighted = false;
 
         int64_t inventoryid = 0;
+        Inventory* inventory = nullptr;
         ItemStack* bound = nullptr;
 
         void performLeftClick(ItemStack& stack, ItemStack& grabbed);
@@ -98,7 +99,7 @@ namespace gui {
         virtual const std::wstring& getTooltip() const override;
 
         void bind(
-            int64_t inventoryid,
+            Inventory& inventory,
             ItemStack& stack,
             const Content* content
         );
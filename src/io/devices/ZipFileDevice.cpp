@@ -1,6 +1,9 @@
 #include "ZipFileDevice.hpp"
 
+#define ZLIB_CONST
+#include <zlib.h>
 #include <vector>
+#include <cstring>
 
 #include "debug/Logger.hpp"
 #include "io/memory_istream.hpp"
@@ -20,6 +23,7 @@ static constexpr uint32_t CENTRAL_DIR_SIGNATURE = 0x02014b50;
 static constexpr uint32_t LOCAL_FILE_SIGNATURE = 0x04034b50;
 static constexpr uint32_t COMPRESSION_NONE = 0;
 static constexpr uint32_t COMPRESSION_DEFLATE = 8;
+static constexpr size_t LOCAL_FILE_HEADER_SIZE = 30;
 
 namespace {
     template<typename T>
@@ -67,6 +71,54 @@ namespace {
         uint16_t time = (tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2);
         return (date << 16) | time;
     }
+
+    void inflate_raw(const char* src, size_t srcSize, char* dst, size_t dstSize) {
+        z_stream zstream {};
+        zstream.next_in = reinterpret_cast<const Bytef*>(src);
+        zstream.avail_in = static_cast<uInt>(srcSize);
+        zstream.next_out = reinterpret_cast<Bytef*>(dst);
+        zstream.avail_out = static_cast<uInt>(dstSize);
+        if (inflateInit2(&zstream, -15) != Z_OK) {
+            throw std::runtime_error("zlib init failed");
+        }
+        int ret = inflate(&zstream, Z_FINISH);
+        inflateEnd(&zstream);
+        if (ret != Z_STREAM_END || zstream.avail_out != 0) {
+            throw std::runtime_error("corrupted deflate data");
+        }
+    }
+}
+
+ZipFileDevice::SharedBuffer ZipFileDevice::EntriesCache::get(
+    const std::string& name
+) {
+    std::lock_guard lock(mutex);
+    const auto& found = items.find(name);
+    if (found == items.end()) {
+        return nullptr;
+    }
+    auto& item = found->second;
+    usage.splice(usage.begin(), usage, item.usage);
+    return item.data;
+}
+
+void ZipFileDevice::EntriesCache::put(
+    const std::string& name, SharedBuffer data
+) {
+    std::lock_guard lock(mutex);
+    if (items.find(name) != items.end()) {
+        return;
+    }
+    usedBytes += data->size();
+    usage.push_front(name);
+    items[name] = Item {std::move(data), usage.begin()};
+
+    while (usedBytes > capacity && !usage.empty()) {
+        const auto& found = items.find(usage.back());
+        usedBytes -= found->second.data->size();
+        items.erase(found);
+        usage.pop_back();
+    }
 }
 
 ZipFileDevice::Entry ZipFileDevice::readEntry() {
@@ -111,7 +163,13 @@ ZipFileDevice::Entry ZipFileDevice::readEntry() {
     return entry;
 }
 
-void ZipFileDevice::findBlob(Entry& entry) {
+void ZipFileDevice::findBlob(Entry& entry, size_t archiveSize) {
+    if (static_cast<size_t>(entry.localHeaderOffset) + LOCAL_FILE_HEADER_SIZE >
+        archiveSize) {
+        throw std::runtime_error(
+            "local file header of " + entry.fileName + " is out of archive"
+        );
+    }
     file->seekg(entry.localHeaderOffset);
     if (read_int<uint32_t>(file) != LOCAL_FILE_SIGNATURE) {
         throw std::runtime_error("invalid local file signature");
@@ -129,7 +187,20 @@ void ZipFileDevice::findBlob(Entry& entry) {
 
     // Skip extra field and file comment
     file->seekg(name_len + extra_field_len, std::ios::cur);
-    entry.blobOffset = file->tellg();
+    entry.blobOffset = entry.localHeaderOffset + LOCAL_FILE_HEADER_SIZE +
+                       name_len + extra_field_len;
+    if (!file->good() || entry.blobOffset > archiveSize ||
+        entry.compressedSize > archiveSize - entry.blobOffset) {
+        throw std::runtime_error(
+            "data of " + entry.fileName + " is out of archive"
+        );
+    }
+    if (entry.compressionMethod == COMPRESSION_NONE &&
+        entry.compressedSize != entry.uncompressedSize) {
+        throw std::runtime_error(
+            "invalid size of stored entry " + entry.fileName
+        );
+    }
 }
 
 ZipFileDevice::ZipFileDevice(
@@ -173,6 +244,8 @@ ZipFileDevice::ZipFileDevice(
         entries[entry.fileName] = std::move(entry);
     }
 
+    // Add directories missing in the central directory
+    std::vector<std::string> directories;
     for (auto& [name, _] : entries) {
         io::path path = name;
 
@@ -180,15 +253,33 @@ ZipFileDevice::ZipFileDevice(
             if (entries.find(path.pathPart()) != entries.end()) {
                 continue;
             }
-            Entry entry {};
-            entry.isDirectory = true;
-            entries[path.pathPart()] = entry;
+            directories.push_back(path.pathPart());
         }
-        break;
+    }
+    for (auto& name : directories) {
+        Entry entry {};
+        entry.isDirectory = true;
+        entries[name] = entry;
     }
 
+    size_t archive_size = static_cast<size_t>(file_size);
     for (auto& [_, entry] : entries) {
-        findBlob(entry);
+        if (!entry.isDirectory) {
+            findBlob(entry, archive_size);
+        }
+    }
+
+    if (archive_size <= (this->separateFunc ? MAX_IN_MEMORY_SEPARABLE_ARCHIVE
+                                            : MAX_IN_MEMORY_ARCHIVE)) {
+        auto buffer = std::make_shared<util::Buffer<char>>(archive_size);
+        file->seekg(0);
+        file->read(buffer->data(), buffer->size());
+        if (static_cast<size_t>(file->gcount()) == archive_size) {
+            archive = std::move(buffer);
+        } else {
+            logger.warning() << "could not load archive to memory";
+            file->clear();
+        }
     }
 }
 
@@ -200,40 +291,90 @@ std::unique_ptr<std::ostream> ZipFileDevice::write(std::string_view path) {
     return nullptr;
 }
 
-std::unique_ptr<std::istream> ZipFileDevice::read(std::string_view path) {
+const ZipFileDevice::Entry& ZipFileDevice::requireFile(
+    std::string_view path
+) const {
     const auto& found = entries.find(std::string(path));
     if (found == entries.end()) {
         throw std::runtime_error("could not to open file zip://" + std::string(path));
     }
-    auto& entry = found->second;
+    const auto& entry = found->second;
     if (entry.isDirectory) {
         throw std::runtime_error("zip://" + std::string(path) + " is directory");
     }
-    if (entry.blobOffset == 0) {
-        findBlob(entry);
-    }
-    std::unique_ptr<std::istream> src_stream;
-    if (separateFunc) {
-        // Create new istream for concurrent data reading
-        src_stream = separateFunc();
-        src_stream->seekg(entry.blobOffset);
+    return entry;
+}
+
+util::Buffer<char> ZipFileDevice::readBlob(const Entry& entry) {
+    util::Buffer<char> buffer(entry.compressedSize);
+    if (archive) {
+        std::memcpy(
+            buffer.data(), archive->data() + entry.blobOffset, buffer.size()
+        );
+    } else if (separateFunc) {
+        auto stream = separateFunc();
+        stream->seekg(entry.blobOffset);
+        stream->read(buffer.data(), buffer.size());
     } else {
-        // Read compressed data to memory if istream cannot be separated
+        std::lock_guard lock(fileMutex);
         file->seekg(entry.blobOffset);
-        util::Buffer<char> buffer(entry.compressedSize);
         file->read(buffer.data(), buffer.size());
-        src_stream = std::make_unique<memory_istream>(std::move(buffer));
     }
-    if (entry.compressionMethod == COMPRESSION_NONE) {
-        return src_stream;
-    } else if (entry.compressionMethod == COMPRESSION_DEFLATE) {
-        return std::make_unique<deflate_istream>(std::move(src_stream));
+    return buffer;
+}
+
+std::unique_ptr<std::istream> ZipFileDevice::openBlob(const Entry& entry) {
+    if (archive) {
+        return std::make_unique<shared_memory_istream>(
+            archive, entry.blobOffset, entry.compressedSize
+        );
+    } else if (separateFunc) {
+        // Create new istream for concurrent data reading
+        auto stream = separateFunc();
+        stream->seekg(entry.blobOffset);
+        return stream;
+    }
+    // Read compressed data to memory if istream cannot be separated
+    return std::make_unique<memory_istream>(readBlob(entry));
+}
+
+ZipFileDevice::SharedBuffer ZipFileDevice::inflateEntry(const Entry& entry) {
+    util::Buffer<char> compressed;
+    const char* src;
+    if (archive) {
+        src = archive->data() + entry.blobOffset;
     } else {
+        compressed = readBlob(entry);
+        src = compressed.data();
+    }
+    auto buffer = std::make_shared<util::Buffer<char>>(entry.uncompressedSize);
+    inflate_raw(
+        src, entry.compressedSize, buffer->data(), buffer->size()
+    );
+    return buffer;
+}
+
+std::unique_ptr<std::istream> ZipFileDevice::read(std::string_view path) {
+    const auto& entry = requireFile(path);
+    if (entry.compressionMethod == COMPRESSION_NONE) {
+        return openBlob(entry);
+    } else if (entry.compressionMethod != COMPRESSION_DEFLATE) {
         throw std::runtime_error(
             "unsupported compression method [" +
             std::to_string(entry.compressionMethod) + "]"
         );
     }
+    if (entry.uncompressedSize > MAX_CACHED_ENTRY_SIZE) {
+        return std::make_unique<deflate_istream>(openBlob(entry));
+    }
+    const auto& name = entry.fileName;
+    auto data = cache.get(name);
+    if (data == nullptr) {
+        data = inflateEntry(entry);
+        cache.put(name, data);
+    }
+    size_t size = data->size();
+    return std::make_unique<shared_memory_istream>(std::move(data), 0, size);
 }
 
 size_t ZipFileDevice::size(std::string_view path) {
@@ -393,6 +534,9 @@ static size_t write_zip(
     size_t entries = 0;
     for (const auto& entry : io::directory_iterator(folder)) {
         auto name = entry.pathPart().substr(root.length());
+        if (!name.empty() && name[0] == '/') {
+            name = name.substr(1);
+        }
         auto last_write_time = io::last_write_time(entry);
         if (io::is_directory(entry)) {
             name = name + "/";
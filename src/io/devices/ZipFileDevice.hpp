@@ -1,9 +1,12 @@
 #pragma once
 
+#include <list>
+#include <mutex>
 #include <functional>
 #include <unordered_map>
 
 #include "Device.hpp"
+#include "util/Buffer.hpp"
 
 namespace io {
     class ZipFileDevice : public Device {
@@ -25,12 +28,46 @@ namespace io {
             size_t blobOffset = 0;
             bool isDirectory = false;
         };
+        using SharedBuffer = std::shared_ptr<const util::Buffer<char>>;
+
+        /// @brief Bounded LRU cache of inflated entries
+        class EntriesCache {
+        public:
+            EntriesCache(size_t capacity) : capacity(capacity) {}
+
+            SharedBuffer get(const std::string& name);
+            void put(const std::string& name, SharedBuffer data);
+        private:
+            struct Item {
+                SharedBuffer data;
+                std::list<std::string>::iterator usage;
+            };
+            size_t capacity;
+            size_t usedBytes = 0;
+            /// @brief Names from the most recently used to the least
+            std::list<std::string> usage;
+            std::unordered_map<std::string, Item> items;
+            std::mutex mutex;
+        };
     public:
+        /// @brief Archives not larger than that are loaded to memory on
+        /// creation if the stream cannot be separated, entries are read
+        /// then without seeking a shared stream
+        static constexpr size_t MAX_IN_MEMORY_ARCHIVE = 16 * 1024 * 1024;
+        /// @brief Archives not larger than that are loaded to memory even
+        /// if entries may be streamed from separate istreams
+        static constexpr size_t MAX_IN_MEMORY_SEPARABLE_ARCHIVE = 1024 * 1024;
+        /// @brief Compressed entries not larger than that (when inflated)
+        /// are kept in the cache after reading
+        static constexpr size_t MAX_CACHED_ENTRY_SIZE = 64 * 1024;
+        static constexpr size_t CACHE_CAPACITY = 4 * 1024 * 1024;
+
         using FileSeparateFunc = std::function<std::unique_ptr<std::istream>()>;
 
         /// @param file ZIP file seekable istream
         /// @param separateFunc Optional function that creates new seekable 
         /// istream for the ZIP file.
+        /// @note read is thread-safe
         ZipFileDevice(
             std::unique_ptr<std::istream> file,
             FileSeparateFunc separateFunc = nullptr
@@ -51,11 +88,25 @@ namespace io {
         std::unique_ptr<PathsGenerator> list(std::string_view path) override;
     private:
         std::unique_ptr<std::istream> file;
+        /// @brief Guards the shared file stream after construction
+        std::mutex fileMutex;
         FileSeparateFunc separateFunc;
+        /// @brief Whole archive if it's small enough, nullptr otherwise
+        SharedBuffer archive;
+        /// @brief Not modified after construction
         std::unordered_map<std::string, Entry> entries;
+        EntriesCache cache {CACHE_CAPACITY};
 
         Entry readEntry();
-        void findBlob(Entry& entry);
+        /// @brief Find entry data offset and check that the data is inside
+        /// of the archive
+        void findBlob(Entry& entry, size_t archiveSize);
+        const Entry& requireFile(std::string_view path) const;
+        /// @brief Read compressed data of the entry
+        util::Buffer<char> readBlob(const Entry& entry);
+        /// @brief Open stream of compressed data of the entry
+        std::unique_ptr<std::istream> openBlob(const Entry& entry);
+        SharedBuffer inflateEntry(const Entry& entry);
     };
 
     void write_zip(const path& folder, const path& file);
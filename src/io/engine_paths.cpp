@@ -34,6 +34,7 @@ static debug::Logger logger("engine-paths");
 static inline io::path SCREENSHOTS_FOLDER = "user:screenshots";
 static inline io::path CONTENT_FOLDER = "user:content";
 static inline io::path WORLDS_FOLDER = "user:worlds";
+static inline io::path BACKUPS_FOLDER = "user:backups";
 
 void EnginePaths::prepare() {
     io::set_device("res", std::make_shared<io::StdfsDevice>(resourcesFolder, false));
@@ -89,6 +90,25 @@ io::path EnginePaths::getNewScreenshotFile(const std::string& ext) {
     return file;
 }
 
+io::path EnginePaths::getNewBackupFolder(const std::string& worldName) {
+    auto t = std::time(nullptr);
+    auto tm = *std::localtime(&t);
+
+    const char* format = "%Y-%m-%d_%H-%M-%S";
+    std::stringstream ss;
+    ss << std::put_time(&tm, format);
+    std::string datetimestr = ss.str();
+
+    auto folder = BACKUPS_FOLDER / worldName / datetimestr;
+    uint index = 0;
+    while (io::exists(folder)) {
+        folder = BACKUPS_FOLDER / worldName /
+                 (datetimestr + "-" + std::to_string(index));
+        index++;
+    }
+    return folder;
+}
+
 io::path EnginePaths::getWorldsFolder() const {
     return WORLDS_FOLDER;
 }
@@ -64,6 +64,7 @@ public:
     void setCurrentWorldFolder(io::path folder);
     io::path getCurrentWorldFolder();
     io::path getNewScreenshotFile(const std::string& ext);
+    io::path getNewBackupFolder(const std::string& worldName);
 
     std::string mount(const io::path& file);
     void unmount(const std::string& name);
@@ -286,6 +286,12 @@ bool io::copy(const io::path& src, const io::path& dst) {
     return output->good();
 }
 
+bool io::rename(const io::path& src, const io::path& dst) {
+    std::error_code ec;
+    std::filesystem::rename(io::resolve(src), io::resolve(dst), ec);
+    return !ec;
+}
+
 uint64_t io::copy_all(const io::path& src, const io::path& dst) {
     auto& srcDevice = io::require_device(src.entryPoint());
     auto& dstDevice = io::require_device(dst.entryPoint());
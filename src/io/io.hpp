@@ -197,6 +197,11 @@ namespace io {
     /// @return true if success
     bool copy(const io::path& src, const io::path& dst);
 
+    /// @brief Rename or move file replacing the destination file if exists.
+    /// Both paths must be resolvable to the same filesystem
+    /// @return true if success
+    bool rename(const io::path& src, const io::path& dst);
+
     /// @brief Copy all files and directories in the folder recursively
     uint64_t copy_all(const io::path& src, const io::path& dst);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <istream>
 #include "util/Buffer.hpp"
 
@@ -32,3 +33,42 @@ public:
 private:
     memory_streambuf buf;
 };
+
+/// @brief Read-only view of a shared buffer region. Holds the buffer, so
+/// any number of streams may read the same memory concurrently
+class shared_memory_streambuf : public std::streambuf {
+public:
+    shared_memory_streambuf(
+        std::shared_ptr<const util::Buffer<char>> buffer,
+        size_t offset,
+        size_t length
+    )
+        : buffer(std::move(buffer)) {
+        char* base = const_cast<char*>(this->buffer->data()) + offset;
+        setg(base, base, base + length);
+    }
+
+    shared_memory_streambuf(const shared_memory_streambuf&) = delete;
+    shared_memory_streambuf& operator=(const shared_memory_streambuf&) = delete;
+
+protected:
+    int_type underflow() override {
+        return traits_type::eof();
+    }
+
+private:
+    std::shared_ptr<const util::Buffer<char>> buffer;
+};
+
+class shared_memory_istream : public std::istream {
+public:
+    shared_memory_istream(
+        std::shared_ptr<const util::Buffer<char>> buffer,
+        size_t offset,
+        size_t length
+    )
+        : std::istream(&buf), buf(std::move(buffer), offset, length) {}
+
+private:
+    shared_memory_streambuf buf;
+};
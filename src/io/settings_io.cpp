@@ -64,6 +64,13 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("load-speed", &settings.chunks.loadSpeed);
     builder.add("padding", &settings.chunks.padding);
 
+    builder.section("tick");
+    builder.add("blocks-budget", &settings.tick.blocksBudget);
+    builder.add("physics-budget", &settings.tick.physicsBudget);
+    builder.add("entities-budget", &settings.tick.entitiesBudget);
+    builder.add("players-budget", &settings.tick.playersBudget);
+    builder.add("block-updates-limit", &settings.tick.blockUpdatesLimit);
+
     builder.section("graphics");
     builder.add("fog-curve", &settings.graphics.fogCurve);
     builder.add("backlight", &settings.graphics.backlight);
@@ -86,6 +93,7 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.section("debug");
     builder.add("generator-test-mode", &settings.debug.generatorTestMode);
     builder.add("do-write-lights", &settings.debug.doWriteLights);
+    builder.add("compact-inventories", &settings.debug.compactInventories);
 }
 
 dv::value SettingsHandler::getValue(const std::string& name) const {
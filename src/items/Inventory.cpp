@@ -1,6 +1,21 @@
 #include "Inventory.hpp"
 
+#include <stdexcept>
+#include <string>
+
 #include "content/ContentReport.hpp"
+#include "coders/binary_json.hpp"
+#include "coders/byte_utils.hpp"
+#include "ItemDef.hpp"
+
+/// @brief Compact inventory format marker. Legacy binary json documents
+/// start with 0x01 (plain) or 0x1F (gzip)
+inline constexpr ubyte INVENTORY_COMPACT_MAGIC = 'I';
+inline constexpr ubyte INVENTORY_COMPACT_VERSION = 1;
+
+inline constexpr ubyte SLOT_EMPTY = 0;
+inline constexpr ubyte SLOT_ITEM = 1;
+inline constexpr ubyte SLOT_ITEM_FIELDS = 2;
 
 Inventory::Inventory(int64_t id, size_t size) : id(id), slots(size) {
 }
@@ -9,11 +24,54 @@ Inventory::Inventory(const Inventory& orig) : id(0) {
     this->slots = orig.slots;
 }
 
+void Inventory::setDirty() {
+    encoded.valid = false;
+    lookupIndex = nullptr;
+    modifiedSlots.clear();
+}
+
+void Inventory::slotModified(size_t slotIndex) {
+    encoded.valid = false;
+    if (lookupIndex == nullptr) {
+        return;
+    }
+    if (modifiedSlots.size() >= slots.size()) {
+        // cheaper to rebuild
+        setDirty();
+        return;
+    }
+    modifiedSlots.push_back(slotIndex);
+}
+
+InventoryIndex* Inventory::getIndex() const {
+    if (slots.size() < INDEXED_MIN_SIZE) {
+        return nullptr;
+    }
+    if (lookupIndex == nullptr || lookupIndex->size() != slots.size()) {
+        lookupIndex = std::make_unique<InventoryIndex>(slots);
+    } else {
+        for (size_t i : modifiedSlots) {
+            lookupIndex->update(i, slots[i]);
+        }
+    }
+    modifiedSlots.clear();
+    return lookupIndex.get();
+}
+
 ItemStack& Inventory::getSlot(size_t index) {
+    auto& slot = slots.at(index);
+    slotModified(index);
+    return slot;
+}
+
+const ItemStack& Inventory::getSlot(size_t index) const {
     return slots.at(index);
 }
 
 size_t Inventory::findEmptySlot(size_t begin, size_t end) const {
+    if (auto index = getIndex()) {
+        return index->findFree(begin, end);
+    }
     end = std::min(slots.size(), end);
     for (size_t i = begin; i < end; i++) {
         if (slots[i].isEmpty()) {
@@ -25,8 +83,23 @@ size_t Inventory::findEmptySlot(size_t begin, size_t end) const {
 
 size_t Inventory::findSlotByItem(
     itemid_t id, size_t begin, size_t end, size_t minCount
-) {
+) const {
     end = std::min(slots.size(), end);
+    auto index = id == ITEM_EMPTY ? nullptr : getIndex();
+    if (index) {
+        auto itemSlots = index->getItemSlots(id);
+        if (itemSlots == nullptr) {
+            return npos;
+        }
+        for (auto it = itemSlots->lower_bound(begin);
+             it != itemSlots->end() && *it < end;
+             ++it) {
+            if (slots[*it].getCount() >= minCount) {
+                return *it;
+            }
+        }
+        return npos;
+    }
     for (size_t i = begin; i < end; i++) {
         const auto& stack = slots[i];
         if (stack.getItemId() == id && stack.getCount() >= minCount) {
@@ -39,26 +112,58 @@ size_t Inventory::findSlotByItem(
 void Inventory::move(
     ItemStack& item, const ContentIndices& indices, size_t begin, size_t end
 ) {
+    encoded.valid = false;
     end = std::min(slots.size(), end);
-    for (size_t i = begin; i < end && !item.isEmpty(); i++) {
-        ItemStack& slot = slots[i];
-        if (!slot.isEmpty() && slot.accepts(item)) {
-            slot.move(item, indices);
+    // item stack with fields changes acceptance after moving to an empty slot
+    auto index = item.hasFields() ? nullptr : getIndex();
+    auto def = indices.items.get(item.getItemId());
+    if (index && def) {
+        index->setStackSize(item.getItemId(), def->stackSize);
+        if (auto partial = index->getPartialSlots(item.getItemId())) {
+            auto it = partial->lower_bound(begin);
+            while (it != partial->end() && *it < end && !item.isEmpty()) {
+                // the slot may be removed from the set when filled
+                size_t i = *(it++);
+                slots[i].move(item, indices);
+                index->update(i, slots[i]);
+            }
         }
-    }
-    for (size_t i = begin; i < end && !item.isEmpty(); i++) {
-        ItemStack& slot = slots[i];
-        if (slot.accepts(item)) {
-            slot.move(item, indices);
+        for (size_t i = index->findFree(begin, end);
+             i != npos && !item.isEmpty();
+             i = index->findFree(i + 1, end)) {
+            slots[i].move(item, indices);
+            index->update(i, slots[i]);
+        }
+    } else {
+        for (size_t i = begin; i < end && !item.isEmpty(); i++) {
+            ItemStack& slot = slots[i];
+            if (!slot.isEmpty() && slot.accepts(item)) {
+                slot.move(item, indices);
+                slotModified(i);
+            }
+        }
+        for (size_t i = begin; i < end && !item.isEmpty(); i++) {
+            ItemStack& slot = slots[i];
+            if (slot.accepts(item)) {
+                slot.move(item, indices);
+                slotModified(i);
+            }
         }
     }
+    // source stack may be a slot of this inventory
+    if (!slots.empty() && &item >= slots.data() &&
+        &item < slots.data() + slots.size()) {
+        slotModified(&item - slots.data());
+    }
 }
 
 void Inventory::resize(uint newSize) {
+    setDirty();
     slots.resize(newSize);
 }
 
 void Inventory::deserialize(const dv::value& src) {
+    setDirty();
     id = src["id"].asInteger(1);
     auto& slotsarr = src["slots"];
     size_t slotscount = slotsarr.size();
@@ -104,7 +209,93 @@ dv::value Inventory::serialize() const {
     return map;
 }
 
+static void encode_compact(
+    ByteBuilder& builder, int64_t id, const std::vector<ItemStack>& slots
+) {
+    builder.put(INVENTORY_COMPACT_MAGIC);
+    builder.put(INVENTORY_COMPACT_VERSION);
+    builder.putInt64(id);
+    builder.putInt32(slots.size());
+    for (const auto& slot : slots) {
+        const auto& fields = slot.getFields();
+        if (slot.isEmpty() && slot.getCount() == 0 && fields == nullptr) {
+            builder.put(SLOT_EMPTY);
+            continue;
+        }
+        builder.put(fields == nullptr ? SLOT_ITEM : SLOT_ITEM_FIELDS);
+        builder.putInt32(slot.getItemId());
+        builder.putInt32(slot.getCount());
+        if (fields != nullptr) {
+            auto bytes = json::to_binary(fields);
+            builder.putInt32(bytes.size());
+            builder.put(bytes.data(), bytes.size());
+        }
+    }
+}
+
+const std::vector<ubyte>& Inventory::encode(bool compact) const {
+    if (encoded.valid && encoded.compact == compact) {
+        return encoded.bytes;
+    }
+    if (compact) {
+        ByteBuilder builder;
+        encode_compact(builder, id, slots);
+        encoded.bytes = builder.build();
+    } else {
+        encoded.bytes = json::to_binary(serialize(), true);
+    }
+    encoded.compact = compact;
+    encoded.valid = true;
+    return encoded.bytes;
+}
+
+void Inventory::decode(const ubyte* src, size_t size) {
+    if (size == 0 || src[0] != INVENTORY_COMPACT_MAGIC) {
+        deserialize(json::from_binary(src, size));
+        return;
+    }
+    setDirty();
+    ByteReader reader(src, size);
+    reader.skip(1);
+    ubyte version = reader.get();
+    if (version != INVENTORY_COMPACT_VERSION) {
+        throw std::runtime_error(
+            "unsupported inventory format version " + std::to_string(version)
+        );
+    }
+    id = reader.getInt64();
+    size_t slotscount = static_cast<uint32_t>(reader.getInt32());
+    if (slots.size() < slotscount) {
+        slots.resize(slotscount);
+    }
+    for (size_t i = 0; i < slotscount; i++) {
+        auto& slot = slots[i];
+        ubyte type = reader.get();
+        if (type == SLOT_EMPTY) {
+            slot.clear();
+            continue;
+        }
+        itemid_t itemid = reader.getInt32();
+        itemcount_t count = reader.getInt32();
+        dv::value fields = nullptr;
+        if (type == SLOT_ITEM_FIELDS) {
+            size_t fieldsSize = static_cast<uint32_t>(reader.getInt32());
+            if (fieldsSize > reader.remaining()) {
+                throw std::runtime_error("buffer underflow");
+            }
+            fields = json::from_binary(reader.pointer(), fieldsSize);
+            reader.skip(fieldsSize);
+        } else if (type != SLOT_ITEM) {
+            throw std::runtime_error(
+                "invalid inventory slot type " + std::to_string(type)
+            );
+        }
+        slot.set(ItemStack(itemid, count, std::move(fields)));
+    }
+}
+
 void Inventory::convert(const ContentReport* report) {
+    setDirty();
     for (auto& slot : slots) {
         itemid_t id = slot.getItemId();
         itemid_t replacement = report->items.getId(id);
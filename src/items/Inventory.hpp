@@ -6,6 +6,7 @@
 #include "interfaces/Serializable.hpp"
 #include "typedefs.hpp"
 #include "ItemStack.hpp"
+#include "InventoryIndex.hpp"
 
 class ContentReport;
 class ContentIndices;
@@ -13,6 +14,22 @@ class ContentIndices;
 class Inventory : public Serializable {
     int64_t id;
     std::vector<ItemStack> slots;
+    /// @brief Encoded inventory cache, valid until the inventory is changed
+    mutable struct {
+        std::vector<ubyte> bytes;
+        bool compact = false;
+        bool valid = false;
+    } encoded;
+    /// @brief Slot lookups index of large inventory, built on demand
+    mutable std::unique_ptr<InventoryIndex> lookupIndex;
+    /// @brief Slots given for modification since the last index update
+    mutable std::vector<size_t> modifiedSlots;
+
+    /// @brief Get up-to-date index or nullptr if the inventory is too small
+    /// to be indexed
+    InventoryIndex* getIndex() const;
+
+    void slotModified(size_t slotIndex);
 public:
     Inventory() = default;
 
@@ -20,11 +37,14 @@ public:
 
     explicit Inventory(const Inventory& orig);
 
+    /// @brief Get slot for modification (invalidates encoded cache, slot
+    /// is re-indexed on the next lookup)
     ItemStack& getSlot(size_t index);
+    const ItemStack& getSlot(size_t index) const;
     size_t findEmptySlot(size_t begin = 0, size_t end = -1) const;
     size_t findSlotByItem(
         itemid_t id, size_t begin = 0, size_t end = -1, size_t minCount = 1
-    );
+    ) const;
 
     void move(
         ItemStack& item,
@@ -39,6 +59,22 @@ public:
 
     dv::value serialize() const override;
 
+    /// @brief Encode inventory. Result is cached until the inventory is
+    /// changed, so unchanged inventories are not re-encoded on every save
+    /// @param compact use compact binary format instead of gzipped binary json
+    const std::vector<ubyte>& encode(bool compact) const;
+
+    /// @brief Decode inventory encoded in any of the encode formats
+    void decode(const ubyte* src, size_t size);
+
+    /// @brief Mark inventory changed. Required after modification of
+    /// stacks references kept outside of the inventory
+    void setDirty();
+
+    bool isDirty() const {
+        return !encoded.valid;
+    }
+
     void convert(const ContentReport* report);
     static void convert(dv::value& data, const ContentReport* report);
 
@@ -48,6 +84,7 @@ public:
 
     void setId(int64_t id) {
         this->id = id;
+        setDirty();
     }
 
     int64_t getId() const {
@@ -59,4 +96,6 @@ public:
     }
 
     static constexpr size_t npos = -1;
+    /// @brief Minimal size of inventory using slot lookups index
+    static constexpr size_t INDEXED_MIN_SIZE = 64;
 };
@@ -0,0 +1,150 @@
+#include "InventoryIndex.hpp"
+
+#include <algorithm>
+
+#include "Inventory.hpp"
+
+inline constexpr size_t WORD_BITS = 64;
+
+static void erase_slot(
+    std::unordered_map<itemid_t, std::set<size_t>>& map,
+    itemid_t id,
+    size_t index
+) {
+    // empty sets are kept as they may be iterated while updating
+    const auto& found = map.find(id);
+    if (found != map.end()) {
+        found->second.erase(index);
+    }
+}
+
+static const std::set<size_t>* find_slots(
+    const std::unordered_map<itemid_t, std::set<size_t>>& map, itemid_t id
+) {
+    const auto& found = map.find(id);
+    if (found == map.end() || found->second.empty()) {
+        return nullptr;
+    }
+    return &found->second;
+}
+
+InventoryIndex::InventoryIndex(const std::vector<ItemStack>& slots)
+    : freeSlots((slots.size() + WORD_BITS - 1) / WORD_BITS),
+      slotItems(slots.size(), ITEM_EMPTY),
+      slotCounts(slots.size(), 0) {
+    for (size_t i = 0; i < slots.size(); i++) {
+        const auto& slot = slots[i];
+        if (slot.isEmpty()) {
+            setFree(i, true);
+        } else {
+            insert(i, slot.getItemId(), slot.getCount());
+        }
+    }
+}
+
+bool InventoryIndex::isPartial(itemid_t id, itemcount_t count) const {
+    const auto& found = stackSizes.find(id);
+    return found == stackSizes.end() || count < found->second;
+}
+
+void InventoryIndex::setFree(size_t index, bool flag) {
+    uint64_t bit = 1ULL << (index % WORD_BITS);
+    if (flag) {
+        freeSlots[index / WORD_BITS] |= bit;
+        firstFreeWord = std::min(firstFreeWord, index / WORD_BITS);
+    } else {
+        freeSlots[index / WORD_BITS] &= ~bit;
+    }
+}
+
+void InventoryIndex::insert(size_t index, itemid_t id, itemcount_t count) {
+    slotItems[index] = id;
+    slotCounts[index] = count;
+    if (id == ITEM_EMPTY) {
+        setFree(index, true);
+        return;
+    }
+    setFree(index, false);
+    itemSlots[id].insert(index);
+    if (isPartial(id, count)) {
+        partialSlots[id].insert(index);
+    }
+}
+
+void InventoryIndex::erase(size_t index, itemid_t id, itemcount_t count) {
+    if (id == ITEM_EMPTY) {
+        return;
+    }
+    erase_slot(itemSlots, id, index);
+    if (isPartial(id, count)) {
+        erase_slot(partialSlots, id, index);
+    }
+}
+
+void InventoryIndex::update(size_t index, const ItemStack& slot) {
+    itemid_t id = slot.isEmpty() ? ITEM_EMPTY : slot.getItemId();
+    itemcount_t count = slot.isEmpty() ? 0 : slot.getCount();
+    itemid_t prevId = slotItems.at(index);
+    itemcount_t prevCount = slotCounts[index];
+    if (prevId == id && prevCount == count) {
+        return;
+    }
+    erase(index, prevId, prevCount);
+    insert(index, id, count);
+}
+
+void InventoryIndex::setStackSize(itemid_t id, itemcount_t stackSize) {
+    const auto& found = stackSizes.find(id);
+    if (found != stackSizes.end() && found->second == stackSize) {
+        return;
+    }
+    stackSizes[id] = stackSize;
+    auto& partial = partialSlots[id];
+    partial.clear();
+    if (auto slots = find_slots(itemSlots, id)) {
+        for (size_t index : *slots) {
+            if (slotCounts[index] < stackSize) {
+                partial.insert(index);
+            }
+        }
+    }
+}
+
+size_t InventoryIndex::findFree(size_t begin, size_t end) const {
+    end = std::min(slotItems.size(), end);
+    if (begin >= end) {
+        return Inventory::npos;
+    }
+    size_t word = std::max(begin / WORD_BITS, firstFreeWord);
+    uint64_t bits = freeSlots[word];
+    if (word * WORD_BITS < begin) {
+        // skip bits before begin in the first word
+        bits &= ~0ULL << (begin % WORD_BITS);
+    }
+    // zero words skipped from the first free word are remembered
+    bool fromFirst = word == firstFreeWord && word * WORD_BITS >= begin;
+    size_t lastWord = (end - 1) / WORD_BITS;
+    while (bits == 0) {
+        if (++word > lastWord) {
+            return Inventory::npos;
+        }
+        if (fromFirst) {
+            firstFreeWord = word;
+        }
+        bits = freeSlots[word];
+    }
+    size_t index = word * WORD_BITS;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        index++;
+    }
+    return index < end ? index : Inventory::npos;
+}
+
+const std::set<size_t>* InventoryIndex::getItemSlots(itemid_t id) const {
+    return find_slots(itemSlots, id);
+}
+
+const std::set<size_t>* InventoryIndex::getPartialSlots(itemid_t id) const {
+    return find_slots(partialSlots, id);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "typedefs.hpp"
+#include "ItemStack.hpp"
+
+/// @brief Inventory slots side index: item id to slots set and free slots
+/// bitset. Used for slot lookups in large inventories
+class InventoryIndex {
+    using SlotsMap = std::unordered_map<itemid_t, std::set<size_t>>;
+
+    SlotsMap itemSlots;
+    /// @brief Slots not filled up to the item stack size. Contains all item
+    /// slots while the stack size is unknown
+    SlotsMap partialSlots;
+    std::unordered_map<itemid_t, itemcount_t> stackSizes;
+    /// @brief Empty slots bitset
+    std::vector<uint64_t> freeSlots;
+    /// @brief All bitset words before this one are zero
+    mutable size_t firstFreeWord = 0;
+    /// @brief Item id and count each slot is currently indexed with
+    std::vector<itemid_t> slotItems;
+    std::vector<itemcount_t> slotCounts;
+
+    bool isPartial(itemid_t id, itemcount_t count) const;
+    void setFree(size_t index, bool flag);
+    void insert(size_t index, itemid_t id, itemcount_t count);
+    void erase(size_t index, itemid_t id, itemcount_t count);
+public:
+    explicit InventoryIndex(const std::vector<ItemStack>& slots);
+
+    /// @brief Update index of a modified slot
+    void update(size_t index, const ItemStack& slot);
+
+    /// @brief Set item stack size used to track partially filled slots
+    void setStackSize(itemid_t id, itemcount_t stackSize);
+
+    /// @brief Find first empty slot in range [begin, end)
+    /// @return slot index or Inventory::npos
+    size_t findFree(size_t begin, size_t end) const;
+
+    /// @brief Get ascending indices of slots containing the item
+    /// @return slots set or nullptr if there are no such slots
+    const std::set<size_t>* getItemSlots(itemid_t id) const;
+
+    /// @brief Get ascending indices of slots containing the item which may
+    /// be not filled up to the stack size
+    /// @return slots set or nullptr if there are no such slots
+    const std::set<size_t>* getPartialSlots(itemid_t id) const;
+
+    size_t size() const {
+        return slotItems.size();
+    }
+};
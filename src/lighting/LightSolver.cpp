@@ -7,10 +7,9 @@
 #include "voxels/Chunks.hpp"
 #include "voxels/Chunk.hpp"
 #include "voxels/voxel.hpp"
-#include "voxels/Block.hpp"
 
 LightSolver::LightSolver(const ContentIndices& contentIds, Chunks& chunks, int channel) 
-    : blockDefs(contentIds.blocks.getDefs()),
+    : properties(contentIds.blockProperties),
       chunks(chunks), 
       channel(channel) {
 }
@@ -77,8 +76,8 @@ void LightSolver::solve(){
                 if (light != 0 && light == entry.light-1){
                     voxel* vox = chunks.get(x, y, z);
                     if (vox && vox->id != 0) {
-                        const Block* block = blockDefs[vox->id];
-                        if (uint8_t emission = block->emission[channel]) {
+                        if (uint8_t emission =
+                                properties.getEmission(vox->id, channel)) {
                             addqueue.push(lightentry {x, y, z, emission});
                             chunk->lightmap.set(lx, y, lz, channel, emission);
                         }
@@ -112,8 +111,7 @@ void LightSolver::solve(){
 
                 ubyte light = chunk->lightmap.get(lx, y, lz, channel);
                 voxel& v = chunk->voxels[vox_index(lx, y, lz)];
-                const Block* block = blockDefs[v.id];
-                if (block->lightPassing && light+2 <= entry.light){
+                if (properties.isLightPassing(v.id) && light+2 <= entry.light){
                     chunk->lightmap.set(
                         x-chunk->x*CHUNK_W, y, z-chunk->z*CHUNK_D, 
                         channel, 
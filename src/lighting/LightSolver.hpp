@@ -4,7 +4,7 @@
 
 class Chunks;
 class ContentIndices;
-class Block;
+class BlockPropertiesTable;
 
 struct lightentry {
     int x;
@@ -16,7 +16,7 @@ struct lightentry {
 class LightSolver {
     std::queue<lightentry> addqueue;
     std::queue<lightentry> remqueue;
-    const Block* const* blockDefs;
+    const BlockPropertiesTable& properties;
     Chunks& chunks;
     int channel;
 public:
@@ -39,22 +39,15 @@ void Lighting::clear(){
 }
 
 void Lighting::prebuildSkyLight(Chunk& chunk, const ContentIndices& indices){
-    const auto* blockDefs = indices.blocks.getDefs();
-
     int highestPoint = 0;
     for (int z = 0; z < CHUNK_D; z++){
         for (int x = 0; x < CHUNK_W; x++){
-            for (int y = CHUNK_H-1; y >= 0; y--){
-                int index = (y * CHUNK_D + z) * CHUNK_W + x;
-                voxel& vox = chunk.voxels[index];
-                const Block* block = blockDefs[vox.id];
-                if (!block->skyLightPassing) {
-                    if (highestPoint < y)
-                        highestPoint = y;
-                    break;
-                }
+            int top = chunk.heights.get(HeightmapType::LIGHT_BLOCKING, x, z);
+            for (int y = CHUNK_H-1; y > top; y--){
                 chunk.lightmap.setS(x,y,z, 15);
             }
+            if (highestPoint < top)
+                highestPoint = top;
         }
     }
     if (highestPoint < CHUNK_H-1)
@@ -63,7 +56,7 @@ void Lighting::prebuildSkyLight(Chunk& chunk, const ContentIndices& indices){
 }
 
 void Lighting::buildSkyLight(int cx, int cz){
-    const auto blockDefs = content.getIndices()->blocks.getDefs();
+    const auto& properties = content.getIndices()->blockProperties;
 
     Chunk* chunk = chunks.getChunk(cx, cz);
     if (chunk == nullptr) {
@@ -75,7 +68,9 @@ void Lighting::buildSkyLight(int cx, int cz){
             int gx = x + cx * CHUNK_W;
             int gz = z + cz * CHUNK_D;
             for (int y = chunk->lightmap.highestPoint; y >= 0; y--){
-                while (y > 0 && !blockDefs[chunk->voxels[vox_index(x, y, z)].id]->lightPassing) {
+                while (y > 0 && !properties.isLightPassing(
+                    chunk->voxels[vox_index(x, y, z)].id
+                )) {
                     y--;
                 }
                 if (chunk->lightmap.getS(x, y, z) != 15) {
@@ -100,7 +95,7 @@ void Lighting::onChunkLoaded(int cx, int cz, bool expand) {
     auto& solverB = *this->solverB;
     auto& solverS = *this->solverS;
 
-    auto blockDefs = content.getIndices()->blocks.getDefs();
+    const auto& properties = content.getIndices()->blockProperties;
     auto chunk = chunks.getChunk(cx, cz);
     if (chunk == nullptr) {
         logger.error() << "attempted to build lights to chunk missing in local matrix";
@@ -109,14 +104,13 @@ void Lighting::onChunkLoaded(int cx, int cz, bool expand) {
     for (uint y = 0; y < CHUNK_H; y++){
         for (uint z = 0; z < CHUNK_D; z++){
             for (uint x = 0; x < CHUNK_W; x++){
-                const voxel& vox = chunk->voxels[(y * CHUNK_D + z) * CHUNK_W + x];
-                const Block* block = blockDefs[vox.id];
-                int gx = x + cx * CHUNK_W;
-                int gz = z + cz * CHUNK_D;
-                if (block->rt.emissive){
-                    solverR.add(gx,y,gz,block->emission[0]);
-                    solverG.add(gx,y,gz,block->emission[1]);
-                    solverB.add(gx,y,gz,block->emission[2]);
+                blockid_t id = chunk->voxels[(y * CHUNK_D + z) * CHUNK_W + x].id;
+                if (properties.isEmissive(id)){
+                    int gx = x + cx * CHUNK_W;
+                    int gz = z + cz * CHUNK_D;
+                    solverR.add(gx,y,gz,properties.getEmission(id, 0));
+                    solverG.add(gx,y,gz,properties.getEmission(id, 1));
+                    solverB.add(gx,y,gz,properties.getEmission(id, 2));
                 }
             }
         }
@@ -213,3 +207,79 @@ void Lighting::onBlockSet(int x, int y, int z, blockid_t id){
         }
     }
 }
+
+void Lighting::onBlocksSet(const std::vector<glm::ivec3>& positions) {
+    const auto& indices = *content.getIndices();
+    LightSolver* solvers[] {
+        solverR.get(), solverG.get(), solverB.get(), solverS.get()
+    };
+
+    for (const auto& pos : positions) {
+        int x = pos.x;
+        int y = pos.y;
+        int z = pos.z;
+        voxel* vox = chunks.get(x, y, z);
+        if (vox == nullptr) {
+            continue;
+        }
+        const auto& block = indices.blocks.require(vox->id);
+        solverR->remove(x, y, z);
+        solverG->remove(x, y, z);
+        solverB->remove(x, y, z);
+        if (vox->id != 0 && !block.skyLightPassing) {
+            solverS->remove(x, y, z);
+            for (int i = y - 1; i >= 0; i--) {
+                solverS->remove(x, i, z);
+                voxel* below = chunks.get(x, i - 1, z);
+                if (i == 0 || below == nullptr || below->id != 0) {
+                    break;
+                }
+            }
+        }
+    }
+    for (auto solver : solvers) {
+        solver->solve();
+    }
+
+    const int coords[] {
+        0, 1, 0,  0, -1, 0,  1, 0, 0,  -1, 0, 0,  0, 0, 1,  0, 0, -1
+    };
+    for (const auto& pos : positions) {
+        int x = pos.x;
+        int y = pos.y;
+        int z = pos.z;
+        voxel* vox = chunks.get(x, y, z);
+        if (vox == nullptr) {
+            continue;
+        }
+        const auto& block = indices.blocks.require(vox->id);
+        if (vox->id == 0) {
+            if (chunks.getLight(x, y + 1, z, 3) == 0xF) {
+                for (int i = y; i >= 0; i--) {
+                    voxel* column = chunks.get(x, i, z);
+                    if ((column == nullptr || column->id != 0) &&
+                        block.skyLightPassing) {
+                        break;
+                    }
+                    solverS->add(x, i, z, 0xF);
+                }
+            }
+            for (int i = 0; i < 6; i++) {
+                int nx = x + coords[i * 3];
+                int ny = y + coords[i * 3 + 1];
+                int nz = z + coords[i * 3 + 2];
+                for (auto solver : solvers) {
+                    solver->add(nx, ny, nz);
+                }
+            }
+        } else if (block.emission[0] || block.emission[1] ||
+                   block.emission[2]) {
+            solverR->add(x, y, z, block.emission[0]);
+            solverG->add(x, y, z, block.emission[1]);
+            solverB->add(x, y, z, block.emission[2]);
+        }
+    }
+    for (auto solver : solvers) {
+        solver->solve();
+    }
+}
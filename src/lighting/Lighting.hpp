@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
 #include "typedefs.hpp"
 
 class Content;
@@ -24,5 +28,11 @@ public:
     void onChunkLoaded(int cx, int cz, bool expand);
     void onBlockSet(int x, int y, int z, blockid_t id);
 
+    /// @brief Update lights after many blocks set at once. Removals and
+    /// additions of all blocks are solved together, so the affected area
+    /// is visited once instead of once per block
+    /// @param positions set blocks positions
+    void onBlocksSet(const std::vector<glm::ivec3>& positions);
+
     static void prebuildSkyLight(Chunk& chunk, const ContentIndices& indices);
 };
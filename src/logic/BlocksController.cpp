@@ -1,12 +1,14 @@
 #include "BlocksController.hpp"
 
-#include <set>
+#include <algorithm>
 
 #include "content/Content.hpp"
 #include "items/Inventories.hpp"
 #include "items/Inventory.hpp"
 #include "lighting/Lighting.hpp"
+#include "logic/ChunksInterest.hpp"
 #include "maths/fastmaths.hpp"
+#include "maths/voxmaths.hpp"
 #include "scripting/scripting.hpp"
 #include "util/timeutil.hpp"
 #include "voxels/Block.hpp"
@@ -17,24 +19,54 @@
 #include "world/Level.hpp"
 #include "world/World.hpp"
 #include "objects/Player.hpp"
-#include "objects/Players.hpp"
 
-BlocksController::BlocksController(const Level& level, Lighting* lighting)
+BlocksController::BlocksController(
+    const Level& level, const ChunksInterest& interest, Lighting* lighting
+)
     : level(level),
       chunks(*level.chunks),
+      interest(interest),
       lighting(lighting),
       randTickClock(20, 3),
       blocksTickClock(20, 1),
       worldTickClock(20, 1) {
+    indexHandlers();
+}
+
+BlocksController::~BlocksController() = default;
+
+void BlocksController::indexHandlers() {
+    const auto& indices = level.content.getIndices()->blocks;
+    auto prevRandomUpdateHandlers = std::move(randomUpdateHandlers);
+    blocksTickHandlers.clear();
+    randomUpdateHandlers.clear();
+    for (blockid_t id = 0; id < indices.count(); id++) {
+        const auto& funcsset = indices.require(id).rt.funcsset;
+        if (funcsset.onblockstick) {
+            blocksTickHandlers.push_back(id);
+        }
+        if (funcsset.randupdate) {
+            randomUpdateHandlers.push_back(id);
+        }
+    }
+    if (prevRandomUpdateHandlers == randomUpdateHandlers) {
+        return;
+    }
+    // counters of all loaded chunks are outdated, including ones out of
+    // the tickets which may get ticket later without reloading
+    const auto& contentIndices = *level.content.getIndices();
+    chunks.forEach([&contentIndices](Chunk& chunk) {
+        chunk.updateRandomUpdateVoxels(contentIndices);
+    });
 }
 
 void BlocksController::updateSides(int x, int y, int z) {
-    updateBlock(x - 1, y, z);
-    updateBlock(x + 1, y, z);
-    updateBlock(x, y - 1, z);
-    updateBlock(x, y + 1, z);
-    updateBlock(x, y, z - 1);
-    updateBlock(x, y, z + 1);
+    scheduleUpdate(x - 1, y, z);
+    scheduleUpdate(x + 1, y, z);
+    scheduleUpdate(x, y - 1, z);
+    scheduleUpdate(x, y + 1, z);
+    scheduleUpdate(x, y, z - 1);
+    scheduleUpdate(x, y, z + 1);
 }
 
 void BlocksController::updateSides(int x, int y, int z, int w, int h, int d) {
@@ -50,7 +82,7 @@ void BlocksController::updateSides(int x, int y, int z, int w, int h, int d) {
                 if (lx >= 0 && lx < w && ly >= 0 && ly < h && lz >= 0 && lz < d) {
                     continue;
                 }
-                updateBlock(
+                scheduleUpdate(
                     x + lx * xaxis.x + ly * yaxis.x + lz * zaxis.x,
                     y + lx * xaxis.y + ly * yaxis.y + lz * zaxis.y,
                     z + lx * xaxis.z + ly * yaxis.z + lz * zaxis.z
@@ -60,6 +92,38 @@ void BlocksController::updateSides(int x, int y, int z, int w, int h, int d) {
     }
 }
 
+bool BlocksController::beginEdit() {
+    if (editBatch) {
+        return false;
+    }
+    editBatch = std::make_unique<blocks_agent::EditBatch>();
+    return true;
+}
+
+blocks_agent::EditBatch* BlocksController::getEditBatch() {
+    return editBatch.get();
+}
+
+size_t BlocksController::commitEdit() {
+    if (editBatch == nullptr) {
+        return 0;
+    }
+    // batch is detached first: updates may set blocks again
+    auto batch = std::move(editBatch);
+    commit(*batch);
+    return batch->positions.size();
+}
+
+void BlocksController::commit(blocks_agent::EditBatch& batch) {
+    blocks_agent::apply(chunks, batch);
+    if (lighting) {
+        lighting->onBlocksSet(batch.positions);
+    }
+    for (const auto& pos : batch.notified) {
+        updateSides(pos.x, pos.y, pos.z);
+    }
+}
+
 void BlocksController::breakBlock(
     Player* player, const Block& def, int x, int y, int z
 ) {
@@ -119,11 +183,72 @@ void BlocksController::updateBlock(int x, int y, int z) {
     }
 }
 
-void BlocksController::update(float delta, uint padding) {
+void BlocksController::scheduleUpdate(int x, int y, int z, int delay) {
+    if (y < 0 || y >= CHUNK_H) {
+        return;
+    }
+    glm::ivec3 pos(x, y, z);
+    uint64_t tick = blocksTick + 1 + std::max(delay, 0);
+    auto found = scheduledTicks.find(pos);
+    if (found != scheduledTicks.end()) {
+        if (found->second <= tick) {
+            return;
+        }
+        // entry in the later tick becomes outdated
+        found->second = tick;
+    } else {
+        scheduledTicks[pos] = tick;
+    }
+    scheduledUpdates[tick].push_back(pos);
+}
+
+void BlocksController::setUpdatesLimit(size_t limit) {
+    updatesLimit = limit;
+}
+
+size_t BlocksController::countScheduledUpdates() const {
+    return scheduledTicks.size();
+}
+
+void BlocksController::processScheduledUpdates() {
+    size_t processed = 0;
+    while (!scheduledUpdates.empty() && processed < updatesLimit) {
+        auto bucket = scheduledUpdates.begin();
+        uint64_t tick = bucket->first;
+        if (tick > blocksTick) {
+            break;
+        }
+        auto& positions = bucket->second;
+        while (!positions.empty() && processed < updatesLimit) {
+            glm::ivec3 pos = positions.front();
+            positions.pop_front();
+
+            auto found = scheduledTicks.find(pos);
+            if (found == scheduledTicks.end() || found->second != tick) {
+                continue;
+            }
+            scheduledTicks.erase(found);
+            // updates scheduled here go to the next ticks
+            updateBlock(pos.x, pos.y, pos.z);
+            processed++;
+        }
+        if (positions.empty()) {
+            scheduledUpdates.erase(bucket);
+        }
+    }
+}
+
+void BlocksController::update(float delta, int64_t maxDuration) {
+    // edit left uncommitted (e.g. script error) must not leave
+    // lights and chunk flags outdated
+    commitEdit();
     if (randTickClock.update(delta)) {
-        randomTick(randTickClock.getPart(), randTickClock.getParts(), padding);
+        randomTick(randTickClock.getPart(), randTickClock.getParts());
     }
+    processRandomTicks(maxDuration);
     if (blocksTickClock.update(delta)) {
+        blocksTick++;
+        processScheduledUpdates();
         onBlocksTick(blocksTickClock.getPart(), blocksTickClock.getParts());
     }
     if (worldTickClock.update(delta)) {
@@ -134,28 +259,31 @@ void BlocksController::update(float delta, uint padding) {
 void BlocksController::onBlocksTick(int tickid, int parts) {
     const auto& indices = level.content.getIndices()->blocks;
     int tickRate = blocksTickClock.getTickRate();
-    for (size_t id = 0; id < indices.count(); id++) {
+    for (blockid_t id : blocksTickHandlers) {
         if ((id + tickid) % parts != 0) continue;
         auto& def = indices.require(id);
         auto interval = def.tickInterval;
-        if (def.rt.funcsset.onblockstick && tickid / parts % interval == 0) {
+        if (tickid / parts % interval == 0) {
             scripting::on_blocks_tick(def, tickRate / interval);
         }
     }
 }
 
 void BlocksController::randomTick(
-    const Chunk& chunk, int segments, const ContentIndices* indices
+    const Chunk& chunk, const ContentIndices& indices
 ) {
-    const int segheight = CHUNK_H / segments;
+    constexpr int segheight = Chunk::RANDOM_UPDATE_SEGMENT_H;
 
-    for (int s = 0; s < segments; s++) {
+    for (int s = 0; s < Chunk::RANDOM_UPDATE_SEGMENTS; s++) {
+        if (chunk.randomUpdateVoxels[s] == 0) {
+            continue;
+        }
         for (int i = 0; i < 4; i++) {
             int bx = random.rand() % CHUNK_W;
             int by = random.rand() % segheight + s * segheight;
             int bz = random.rand() % CHUNK_D;
             const voxel& vox = chunk.voxels[vox_index(bx, by, bz)];
-            auto& block = indices->blocks.require(vox.id);
+            auto& block = indices.blocks.require(vox.id);
             if (block.rt.funcsset.randupdate) {
                 scripting::random_update_block(
                     block,
@@ -168,42 +296,37 @@ void BlocksController::randomTick(
     }
 }
 
-void BlocksController::randomTick(int tickid, int parts, uint padding) {
-    auto indices = level.content.getIndices();
-
-    std::set<uint64_t> chunksIterated;
+void BlocksController::randomTick(int tickid, int parts) {
+    if (randomUpdateHandlers.empty()) {
+        randomTickQueue.clear();
+        randomTickQueued.clear();
+        return;
+    }
+    // unfinished chunks of previous parts are kept and processed first,
+    // chunks still waiting there are not queued again.
+    // Players loading zones union, each chunk is visited once per parts
+    // cycle. Parts are split by position: tickets order is not stable
+    for (const auto& [pos, _] : interest.getTickets()) {
+        if ((floormod(pos.x + pos.y * 31, parts) + tickid) % parts == 0 &&
+            randomTickQueued.insert(pos).second) {
+            randomTickQueue.push_back(pos);
+        }
+    }
+}
 
-    for (const auto& [pid, player] : *level.players) {
-        const auto& chunks = *player->chunks;
-        int offsetX = chunks.getOffsetX();
-        int offsetY = chunks.getOffsetY();
-        int width = chunks.getWidth();
-        int height = chunks.getHeight();
-        int segments = 4;
+void BlocksController::processRandomTicks(int64_t maxDuration) {
+    const auto& indices = *level.content.getIndices();
 
-        for (uint z = padding; z < height - padding; z++) {
-            for (uint x = padding; x < width - padding; x++) {
-                int index = z * width + x;
-                if ((index + tickid) % parts != 0) {
-                    continue;
-                }
-                auto& chunk = chunks.getChunks()[index];
-                if (chunk == nullptr || !chunk->flags.lighted) {
-                    continue;
-                }
-                union {
-                    int32_t pos[2];
-                    uint64_t key;
-                } posU;
-                posU.pos[0] = x + offsetX;
-                posU.pos[1] = z + offsetY;
-                if (chunksIterated.find(posU.key) != chunksIterated.end()) {
-                    continue;
-                }
-                chunksIterated.insert(posU.key);
-                randomTick(*chunk, segments, indices);
-            }
+    timeutil::Timer timer;
+    while (!randomTickQueue.empty() && timer.stop() < maxDuration * 1000) {
+        auto pos = randomTickQueue.front();
+        randomTickQueue.pop_front();
+        randomTickQueued.erase(pos);
+        auto chunk = chunks.getChunk(pos.x, pos.y);
+        if (chunk == nullptr || !chunk->flags.lighted) {
+            continue;
         }
+        randomTick(*chunk, indices);
     }
 }
 
@@ -1,7 +1,15 @@
 #pragma once
 
+#include <map>
+#include <deque>
+#include <vector>
+#include <memory>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
 #include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
 
 #include "maths/fastmaths.hpp"
 #include "typedefs.hpp"
@@ -16,6 +24,11 @@ class Chunks;
 class Lighting;
 class GlobalChunks;
 class ContentIndices;
+class ChunksInterest;
+
+namespace blocks_agent {
+    struct EditBatch;
+}
 
 enum class BlockInteraction { step, destruction, placing };
 
@@ -27,29 +40,96 @@ using on_block_interaction = std::function<
 class BlocksController {
     const Level& level;
     GlobalChunks& chunks;
+    const ChunksInterest& interest;
     Lighting* lighting;
     util::Clock randTickClock;
     util::Clock blocksTickClock;
     util::Clock worldTickClock;
     FastRandom random {};
     std::vector<on_block_interaction> blockInteractionCallbacks;
+    /// @brief Chunks of random tick parts left to process, in order
+    std::deque<glm::ivec2> randomTickQueue;
+    /// @brief Chunks in randomTickQueue, each is queued once
+    std::unordered_set<glm::ivec2> randomTickQueued;
+    /// @brief Blocks edit in progress (see beginEdit)
+    std::unique_ptr<blocks_agent::EditBatch> editBatch;
+    /// @brief Scheduled blocks updates by blocks tick number
+    std::map<uint64_t, std::deque<glm::ivec3>> scheduledUpdates;
+    /// @brief Blocks tick of the update scheduled for position. Entries
+    /// of scheduledUpdates not matching it are outdated
+    std::unordered_map<glm::ivec3, uint64_t> scheduledTicks;
+    /// @brief Blocks ticks counter
+    uint64_t blocksTick = 0;
+    size_t updatesLimit = 4096;
+    /// @brief Sorted ids of blocks having on_blocks_tick handler
+    std::vector<blockid_t> blocksTickHandlers;
+    /// @brief Sorted ids of blocks having on_random_update handler
+    std::vector<blockid_t> randomUpdateHandlers;
+
+    /// @brief Process due scheduled updates until limit is reached
+    void processScheduledUpdates();
+
+    /// @brief Process queued random ticks until time is out
+    /// @param maxDuration milliseconds, 0 - process nothing
+    void processRandomTicks(int64_t maxDuration);
 public:
-    BlocksController(const Level& level, Lighting* lighting);
+    BlocksController(
+        const Level& level, const ChunksInterest& interest, Lighting* lighting
+    );
+    ~BlocksController();
 
+    /// @brief Rebuild blocks handlers lists used by ticks. Must be called
+    /// after block script is (re)loaded
+    void indexHandlers();
+
+    /// @brief Schedule update of the block neighbours
     void updateSides(int x, int y, int z);
+    /// @brief Schedule update of the extended block neighbours
     void updateSides(int x, int y, int z, int w, int h, int d);
     void updateBlock(int x, int y, int z);
 
+    /// @brief Schedule block update. Position scheduled multiple times is
+    /// updated once, at the earliest scheduled tick
+    /// @param delay number of blocks ticks to skip
+    void scheduleUpdate(int x, int y, int z, int delay = 0);
+
+    /// @param limit max scheduled updates processed per blocks tick,
+    /// the rest is left for the next ticks
+    void setUpdatesLimit(size_t limit);
+
+    /// @return number of scheduled updates
+    size_t countScheduledUpdates() const;
+
+    /// @brief Start collecting blocks set into an edit batch. Batch is
+    /// committed by commitEdit or on the next update
+    /// @return false if an edit is already in progress
+    bool beginEdit();
+
+    /// @return edit batch in progress or nullptr
+    blocks_agent::EditBatch* getEditBatch();
+
+    /// @brief Apply side effects of the edit in progress: chunks flags,
+    /// one combined lights update and one update per affected neighbour
+    /// block
+    /// @return number of blocks set
+    size_t commitEdit();
+
+    /// @brief Apply side effects of the batch (see commitEdit)
+    void commit(blocks_agent::EditBatch& batch);
+
     void breakBlock(Player* player, const Block& def, int x, int y, int z);
     void placeBlock(
         Player* player, const Block& def, blockstate state, int x, int y, int z
     );
 
-    void update(float delta, uint padding);
-    void randomTick(
-        const Chunk& chunk, int segments, const ContentIndices* indices
-    );
-    void randomTick(int tickid, int parts, uint padding);
+    /// @param maxDuration milliseconds reserved for deferrable work
+    /// (random ticks), the rest is continued on the next update
+    void update(float delta, int64_t maxDuration);
+    /// @brief Random update of few random blocks in each chunk segment
+    /// containing blocks having on_random_update handler
+    void randomTick(const Chunk& chunk, const ContentIndices& indices);
+    /// @brief Queue random ticks of the loading zone chunks part
+    void randomTick(int tickid, int parts);
     void onBlocksTick(int tickid, int parts);
     int64_t createBlockInventory(int x, int y, int z);
     void bindInventory(int64_t invid, int x, int y, int z);
@@ -1,6 +1,9 @@
 #include "ChunksController.hpp"
 
 #include <limits.h>
+#include <cmath>
+#include <limits>
+#include <algorithm>
 #include <memory>
 
 #include "content/Content.hpp"
@@ -10,6 +13,7 @@
 #include "maths/voxmaths.hpp"
 #include "util/timeutil.hpp"
 #include "objects/Player.hpp"
+#include "objects/Players.hpp"
 #include "voxels/Block.hpp"
 #include "voxels/Chunk.hpp"
 #include "voxels/Chunks.hpp"
@@ -19,7 +23,6 @@
 #include "world/generator/WorldGenerator.hpp"
 
 const uint MAX_WORK_PER_FRAME = 128;
-const uint MIN_SURROUNDING = 9;
 
 ChunksController::ChunksController(Level& level)
     : level(level),
@@ -27,29 +30,43 @@ ChunksController::ChunksController(Level& level)
           level.content.generators.require(level.getWorld()->getGenerator()),
           level.content,
           level.getWorld()->getSeed()
-      )) {}
+      )) {
+    level.chunks->setOnSurrounded([this](Chunk& chunk) {
+        if (!chunk.flags.lighted) {
+            lightsQueue.emplace(chunk.x, chunk.z);
+        }
+    });
+}
 
-ChunksController::~ChunksController() = default;
+ChunksController::~ChunksController() {
+    level.chunks->setOnSurrounded(nullptr);
+}
 
-void ChunksController::update(
-    int64_t maxDuration, int loadDistance, uint padding, Player& player
-) const {
-    const auto& position = player.getPosition();
-    int centerX = floordiv<CHUNK_W>(glm::floor(position.x));
-    int centerY = floordiv<CHUNK_D>(glm::floor(position.z));
-    
-    if (player.isLoadingChunks()) {
-        /// FIXME: one generator for multiple players
-        generator->update(centerX, centerY, loadDistance);
-    } else {
-        return;
+void ChunksController::update(int64_t maxDuration, int loadDistance) {
+    if (interest.update(*level.players, loadDistance)) {
+        const auto& areas = interest.getAreas();
+        for (int64_t id : interest.getChangedAreas()) {
+            const auto& found = areas.find(id);
+            if (found != areas.end()) {
+                unloadInvisible(*found->second.player->chunks);
+            }
+        }
+        for (const auto& pos : interest.getAddedTickets()) {
+            if (auto chunk = level.chunks->fetch(pos.x, pos.y)) {
+                attachChunk(chunk);
+                checkLightsReady(pos.x, pos.y);
+            } else if (queued.insert(pos).second) {
+                loadQueue.push_back({0.0f, pos});
+            }
+        }
+        rebuildLoadQueue();
     }
 
     int64_t mcstotal = 0;
 
     for (uint i = 0; i < MAX_WORK_PER_FRAME; i++) {
         timeutil::Timer timer;
-        if (loadVisible(player, padding)) {
+        if (loadVisible()) {
             int64_t mcs = timer.stop();
             if (mcstotal + mcs < maxDuration * 1000) {
                 mcstotal += mcs;
@@ -60,6 +77,65 @@ void ChunksController::update(
     }
 }
 
+float ChunksController::getLoadPriority(int x, int z) const {
+    float priority = std::numeric_limits<float>::infinity();
+    for (const auto& [_, area] : interest.getAreas()) {
+        if (!area.contains(x, z)) {
+            continue;
+        }
+        int distance = area.distance(x, z);
+        float dot = 1.0f;
+        if (distance) {
+            glm::vec2 dir(x - area.centerX, z - area.centerZ);
+            dot = glm::dot(dir, area.direction) / std::sqrt(distance);
+        }
+        // chunks behind the player are twice as far as in front of
+        priority = std::min(priority, distance * (3.0f - dot) * 0.5f);
+    }
+    return priority;
+}
+
+void ChunksController::rebuildLoadQueue() {
+    for (size_t i = 0; i < loadQueue.size();) {
+        auto& entry = loadQueue[i];
+        if (!interest.isInterested(entry.pos.x, entry.pos.y) ||
+            level.chunks->getChunk(entry.pos.x, entry.pos.y)) {
+            queued.erase(entry.pos);
+            entry = loadQueue.back();
+            loadQueue.pop_back();
+            continue;
+        }
+        entry.priority = getLoadPriority(entry.pos.x, entry.pos.y);
+        i++;
+    }
+    std::make_heap(loadQueue.begin(), loadQueue.end());
+}
+
+void ChunksController::updateGenerator(int x, int z) {
+    glm::ivec2 min, max;
+    if (!interest.getBounds(min, max)) {
+        return;
+    }
+    const auto& nearest = *interest.getNearestArea(x, z);
+    int extent = std::max(max.x - min.x, max.y - min.y);
+
+    glm::ivec3 area;
+    if (extent <= nearest.radius * 4) {
+        // players are close enough to share single generator area
+        area = glm::ivec3(
+            floordiv(min.x + max.x, 2),
+            floordiv(min.y + max.y, 2),
+            (extent + 1) / 2
+        );
+    } else {
+        area = glm::ivec3(nearest.centerX, nearest.centerZ, nearest.radius);
+    }
+    if (area != generatorArea) {
+        generator->update(area.x, area.y, area.z);
+        generatorArea = area;
+    }
+}
+
 bool ChunksController::isInLoadingZone(
     const Player& player, uint padding, int x, int z
 ) const {
@@ -76,15 +152,9 @@ bool ChunksController::isInLoadingZone(
     return distance < minDistance;
 }
 
-bool ChunksController::loadVisible(const Player& player, uint padding) const {
-    auto& chunks = *player.chunks;
+void ChunksController::unloadInvisible(Chunks& chunks) const {
     int sizeX = chunks.getWidth();
     int sizeY = chunks.getHeight();
-
-    int nearX = 0;
-    int nearZ = 0;
-    bool assigned = false;
-    int minDistance = ((sizeX - padding * 2) / 2) * ((sizeY - padding * 2) / 2);
     int maxDistance = ((sizeX) / 2) * ((sizeY) / 2);
     for (uint z = 0; z < sizeY; z++) {
         for (uint x = 0; x < sizeX; x++) {
@@ -92,92 +162,87 @@ bool ChunksController::loadVisible(const Player& player, uint padding) const {
             int lx = x - sizeX / 2;
             int lz = z - sizeY / 2;
             int distance = (lx * lx + lz * lz);
-            auto& chunk = chunks.getChunks()[index];
-            if (chunk != nullptr) {
-                if (distance >= maxDistance) {
-                    chunks.remove(
-                        x + chunks.getOffsetX(), z + chunks.getOffsetY()
-                    );
-                }
-                continue;
+            if (chunks.getChunks()[index] != nullptr &&
+                distance >= maxDistance) {
+                chunks.remove(x + chunks.getOffsetX(), z + chunks.getOffsetY());
             }
         }
     }
-    for (uint z = padding; z < sizeY - padding; z++) {
-        for (uint x = padding; x < sizeX - padding; x++) {
-            int index = z * sizeX + x;
-            int lx = x - sizeX / 2;
-            int lz = z - sizeY / 2;
-            int distance = (lx * lx + lz * lz);
-            auto& chunk = chunks.getChunks()[index];
-            if (chunk != nullptr) {
-                if (chunk->flags.loaded && !chunk->flags.lighted) {
-                    if (buildLights(player, chunk)) {
-                        return true;
-                    }
-                }
-                continue;
-            }
+}
 
-            if (distance < minDistance) {
-                minDistance = distance;
-                nearX = x;
-                nearZ = z;
-                assigned = true;
-            }
+bool ChunksController::loadVisible() {
+    while (!lightsQueue.empty()) {
+        auto pos = lightsQueue.front();
+        lightsQueue.pop();
+        auto chunk = level.chunks->fetch(pos.x, pos.y);
+        if (chunk && !chunk->flags.lighted &&
+            interest.isInterested(pos.x, pos.y) && buildLights(chunk)) {
+            return true;
         }
     }
-
-    const auto& chunk = chunks.getChunks()[nearZ * sizeX + nearX];
-    if (chunk != nullptr || !assigned || !player.isLoadingChunks()) {
-        return false;
+    while (!loadQueue.empty()) {
+        std::pop_heap(loadQueue.begin(), loadQueue.end());
+        auto pos = loadQueue.back().pos;
+        loadQueue.pop_back();
+        queued.erase(pos);
+        if (!interest.isInterested(pos.x, pos.y) ||
+            level.chunks->getChunk(pos.x, pos.y)) {
+            continue;
+        }
+        createChunk(pos.x, pos.y);
+        return true;
     }
-    int offsetX = chunks.getOffsetX();
-    int offsetY = chunks.getOffsetY();
-    createChunk(player, nearX + offsetX, nearZ + offsetY);
-    return true;
+    return false;
 }
 
-bool ChunksController::buildLights(
-    const Player& player, const std::shared_ptr<Chunk>& chunk
-) const {
-    int surrounding = 0;
-    for (int oz = -1; oz <= 1; oz++) {
-        for (int ox = -1; ox <= 1; ox++) {
-            if (player.chunks->getChunk(chunk->x + ox, chunk->z + oz))
-                surrounding++;
-        }
+void ChunksController::checkLightsReady(int x, int z) {
+    auto chunk = level.chunks->getChunk(x, z);
+    if (chunk && chunk->isSurrounded() && !chunk->flags.lighted) {
+        lightsQueue.emplace(x, z);
     }
-    if (surrounding == MIN_SURROUNDING) {
-        if (lighting) {
-            bool lightsCache = chunk->flags.loadedLights;
-            if (!lightsCache) {
-                lighting->buildSkyLight(chunk->x, chunk->z);
-            }
-            lighting->onChunkLoaded(chunk->x, chunk->z, !lightsCache);
+}
+
+bool ChunksController::attachChunk(const std::shared_ptr<Chunk>& chunk) const {
+    bool attached = false;
+    for (const auto& [_, area] : interest.getAreas()) {
+        auto& chunks = *area.player->chunks;
+        if (!area.contains(chunk->x, chunk->z) ||
+            chunks.getChunk(chunk->x, chunk->z)) {
+            continue;
         }
-        chunk->flags.lighted = true;
-        return true;
+        attached |= chunks.putChunk(chunk);
     }
-    return false;
+    return attached;
 }
 
-void ChunksController::createChunk(const Player& player, int x, int z) const {
-    if (!player.isLoadingChunks()) {
-        if (auto chunk = level.chunks->fetch(x, z)) {
-            player.chunks->putChunk(chunk);
+bool ChunksController::buildLights(const std::shared_ptr<Chunk>& chunk) {
+    if (!chunk->isSurrounded() || !chunk->flags.loaded) {
+        return false;
+    }
+    if (lighting) {
+        bool lightsCache = chunk->flags.loadedLights;
+        if (!lightsCache) {
+            lighting->buildSkyLight(chunk->x, chunk->z);
         }
-        return;
+        lighting->onChunkLoaded(chunk->x, chunk->z, !lightsCache);
     }
+    chunk->flags.lighted = true;
+    return true;
+}
+
+void ChunksController::createChunk(int x, int z) {
+    updateGenerator(x, z);
+
     auto chunk = level.chunks->create(x, z);
-    player.chunks->putChunk(chunk);
+    attachChunk(chunk);
     auto& chunkFlags = chunk->flags;
-
     if (!chunkFlags.loaded) {
         generator->generate(chunk->voxels, x, z);
         chunkFlags.unsaved = true;
     }
     chunk->updateHeights();
+    chunk->heights.build(chunk->voxels, *level.content.getIndices());
+    chunk->updateRandomUpdateVoxels(*level.content.getIndices());
 
     if (!chunkFlags.loadedLights) {
         Lighting::prebuildSkyLight(*chunk, *level.content.getIndices());
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <queue>
 #include <memory>
+#include <vector>
+#include <unordered_set>
 
 #include "typedefs.hpp"
+#include "ChunksInterest.hpp"
 
 class Level;
 class Chunk;
@@ -16,11 +20,45 @@ class ChunksController {
 private:
     Level& level;
     std::unique_ptr<WorldGenerator> generator;
+    struct LoadEntry {
+        float priority;
+        glm::ivec2 pos;
+
+        /// @brief Inverted for std heap functions to make min-heap
+        bool operator<(const LoadEntry& other) const {
+            return priority > other.priority;
+        }
+    };
+
+    /// @brief Shared loading zone of all players
+    ChunksInterest interest;
+    /// @brief Missing chunks min-heap ordered by distance and view direction
+    std::vector<LoadEntry> loadQueue;
+    /// @brief Positions present in the load queue
+    std::unordered_set<glm::ivec2> queued;
+    /// @brief Chunks got all neighbours present, filled by
+    /// GlobalChunks surround callback
+    std::queue<glm::ivec2> lightsQueue;
+    /// @brief Current generator area (center x, center z, radius)
+    glm::ivec3 generatorArea {0, 0, -1};
 
     /// @brief Process one chunk: load it or calculate lights for it
-    bool loadVisible(const Player& player, uint padding) const;
-    bool buildLights(const Player& player, const std::shared_ptr<Chunk>& chunk) const;
-    void createChunk(const Player& player, int x, int y) const;
+    bool loadVisible();
+    /// @brief Recalculate priorities and drop obsolete load queue entries
+    void rebuildLoadQueue();
+    float getLoadPriority(int x, int z) const;
+    /// @brief Push chunk to lights queue if it's surrounded but not lighted
+    /// (used for chunks surrounded before entering the loading zone)
+    void checkLightsReady(int x, int z);
+    bool buildLights(const std::shared_ptr<Chunk>& chunk);
+    void createChunk(int x, int y);
+    /// @brief Put chunk to matrices of all interested players
+    /// @return true if chunk has been put to at least one matrix
+    bool attachChunk(const std::shared_ptr<Chunk>& chunk) const;
+    /// @brief Remove chunks out of the player matrix visible zone
+    void unloadInvisible(Chunks& chunks) const;
+    /// @brief Move generator area to cover chunk position
+    void updateGenerator(int x, int z);
 public:
     std::unique_ptr<Lighting> lighting;
 
@@ -28,13 +66,16 @@ public:
     ~ChunksController();
 
     /// @param maxDuration milliseconds reserved for chunks loading
-    void update(
-        int64_t maxDuration, int loadDistance, uint padding, Player& player
-    ) const;
+    /// @param loadDistance chunks loading radius of each player
+    void update(int64_t maxDuration, int loadDistance);
 
     bool isInLoadingZone(const Player& player, uint padding, int x, int z) const;
 
     const WorldGenerator* getGenerator() const {
         return generator.get();
     }
+
+    const ChunksInterest& getInterest() const {
+        return interest;
+    }
 };
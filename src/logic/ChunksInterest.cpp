@@ -0,0 +1,184 @@
+#include "ChunksInterest.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <unordered_set>
+
+#include "constants.hpp"
+#include "maths/voxmaths.hpp"
+#include "objects/Player.hpp"
+#include "objects/Players.hpp"
+
+ChunksInterest::ChunksInterest() = default;
+
+ChunksInterest::~ChunksInterest() = default;
+
+bool InterestArea::getRow(int z, int& begin, int& end) const {
+    int dz = z - centerZ;
+    if (dz < -radius || dz >= radius) {
+        return false;
+    }
+    // max dx where dx * dx + dz * dz < radius * radius
+    int left = radius * radius - dz * dz;
+    if (left <= 0) {
+        return false;
+    }
+    int dx = static_cast<int>(std::sqrt(static_cast<float>(left)));
+    while (dx * dx >= left) {
+        dx--;
+    }
+    while ((dx + 1) * (dx + 1) < left) {
+        dx++;
+    }
+    begin = centerX - dx;
+    end = centerX + dx + 1;
+    return true;
+}
+
+/// @brief Call func for each chunk position contained in the area but not
+/// in the other one
+/// @param other nullable
+template <typename Func>
+static void for_each_exclusive(
+    const InterestArea& area, const InterestArea* other, const Func& func
+) {
+    int r = area.radius;
+    for (int z = area.centerZ - r; z < area.centerZ + r; z++) {
+        int begin, end;
+        if (!area.getRow(z, begin, end)) {
+            continue;
+        }
+        int otherBegin = end;
+        int otherEnd = end;
+        if (other && !other->getRow(z, otherBegin, otherEnd)) {
+            otherBegin = otherEnd = end;
+        }
+        for (int x = begin; x < std::min(end, otherBegin); x++) {
+            func(x, z);
+        }
+        for (int x = std::max(begin, otherEnd); x < end; x++) {
+            func(x, z);
+        }
+    }
+}
+
+void ChunksInterest::addArea(
+    const InterestArea& area, const InterestArea* prev
+) {
+    for_each_exclusive(area, prev, [this](int x, int z) {
+        tickets[{x, z}].refs++;
+        addedTickets.emplace_back(x, z);
+    });
+}
+
+void ChunksInterest::removeArea(
+    const InterestArea& area, const InterestArea* next
+) {
+    for_each_exclusive(area, next, [this](int x, int z) {
+        const auto& found = tickets.find({x, z});
+        if (found != tickets.end() && --found->second.refs == 0) {
+            tickets.erase(found);
+        }
+    });
+}
+
+/// @brief Get view direction sector index
+static int get_sector(float yaw) {
+    int sector = static_cast<int>(std::floor((yaw + 180.0f) / 45.0f));
+    return ((sector % 8) + 8) % 8;
+}
+
+bool ChunksInterest::update(const Players& players, int loadDistance) {
+    changedAreas.clear();
+    addedTickets.clear();
+    bool turned = false;
+
+    std::unordered_set<int64_t> present;
+    for (const auto& [id, player] : players) {
+        if (player->isSuspended() || !player->isLoadingChunks()) {
+            continue;
+        }
+        const auto& position = player->getPosition();
+        InterestArea area {
+            player.get(),
+            floordiv<CHUNK_W>(glm::floor(position.x)),
+            floordiv<CHUNK_D>(glm::floor(position.z)),
+            loadDistance};
+        float yaw = player->getRotation().x;
+        area.direction = glm::vec2(
+            -std::sin(glm::radians(yaw)), -std::cos(glm::radians(yaw))
+        );
+        area.sector = get_sector(yaw);
+        present.insert(id);
+
+        const auto& found = areas.find(id);
+        if (found != areas.end()) {
+            auto& current = found->second;
+            current.player = player.get();
+            current.direction = area.direction;
+            if (current.sector != area.sector) {
+                current.sector = area.sector;
+                turned = true;
+            }
+            if (current == area) {
+                continue;
+            }
+            // only chunks left and entered by the area are updated
+            removeArea(current, &area);
+            addArea(area, &current);
+            current = area;
+        } else {
+            addArea(area, nullptr);
+            areas[id] = area;
+        }
+        changedAreas.push_back(id);
+    }
+    for (auto it = areas.begin(); it != areas.end();) {
+        if (present.find(it->first) != present.end()) {
+            ++it;
+            continue;
+        }
+        InterestArea prev = it->second;
+        changedAreas.push_back(it->first);
+        it = areas.erase(it);
+        removeArea(prev, nullptr);
+    }
+    return turned || !changedAreas.empty();
+}
+
+const ChunkTicket* ChunksInterest::getTicket(int x, int z) const {
+    const auto& found = tickets.find({x, z});
+    if (found == tickets.end()) {
+        return nullptr;
+    }
+    return &found->second;
+}
+
+bool ChunksInterest::getBounds(glm::ivec2& min, glm::ivec2& max) const {
+    if (areas.empty()) {
+        return false;
+    }
+    min = glm::ivec2(std::numeric_limits<int>::max());
+    max = glm::ivec2(std::numeric_limits<int>::min());
+    for (const auto& [_, area] : areas) {
+        min.x = std::min(min.x, area.centerX - area.radius);
+        min.y = std::min(min.y, area.centerZ - area.radius);
+        max.x = std::max(max.x, area.centerX + area.radius);
+        max.y = std::max(max.y, area.centerZ + area.radius);
+    }
+    return true;
+}
+
+const InterestArea* ChunksInterest::getNearestArea(int x, int z) const {
+    const InterestArea* nearest = nullptr;
+    int minDistance = std::numeric_limits<int>::max();
+    for (const auto& [_, area] : areas) {
+        int distance = area.distance(x, z);
+        if (distance < minDistance) {
+            minDistance = distance;
+            nearest = &area;
+        }
+    }
+    return nearest;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "typedefs.hpp"
+
+class Player;
+class Players;
+
+/// @brief Chunks loading area of a single player
+struct InterestArea {
+    Player* player;
+    /// @brief area center chunk position
+    int centerX;
+    int centerZ;
+    /// @brief load radius in chunks
+    int radius;
+    /// @brief normalized player view direction projected to XZ plane
+    glm::vec2 direction {0.0f, -1.0f};
+    /// @brief view direction sector index (one of 8)
+    int sector = 0;
+
+    bool operator==(const InterestArea& other) const {
+        return centerX == other.centerX && centerZ == other.centerZ &&
+               radius == other.radius;
+    }
+
+    bool operator!=(const InterestArea& other) const {
+        return !(*this == other);
+    }
+
+    /// @return squared distance to the area center
+    int distance(int x, int z) const {
+        int dx = x - centerX;
+        int dz = z - centerZ;
+        return dx * dx + dz * dz;
+    }
+
+    bool contains(int x, int z) const {
+        int dx = x - centerX;
+        int dz = z - centerZ;
+        return dx >= -radius && dx < radius && dz >= -radius && dz < radius &&
+               dx * dx + dz * dz < radius * radius;
+    }
+
+    /// @brief Get contained chunks of the row (see contains)
+    /// @param z row chunk position Z
+    /// @param begin first contained chunk position X
+    /// @param end position X after the last contained chunk
+    /// @return false if the row has no contained chunks
+    bool getRow(int z, int& begin, int& end) const;
+};
+
+/// @brief Chunk ticket holding it in the shared loading zone
+struct ChunkTicket {
+    /// @brief number of areas containing the chunk
+    int refs = 0;
+};
+
+/// @brief Shared chunks interest management. Combines loading areas of all
+/// chunk-loading players into reference-counted chunk tickets, so
+/// overlapping areas are processed once per tick.
+class ChunksInterest {
+    std::unordered_map<int64_t, InterestArea> areas;
+    std::unordered_map<glm::ivec2, ChunkTicket> tickets;
+    /// @brief ids of players which area has been changed on last update
+    std::vector<int64_t> changedAreas;
+    /// @brief positions entered by areas on last update
+    std::vector<glm::ivec2> addedTickets;
+
+    /// @brief Add references of the area chunks not contained in prev
+    void addArea(const InterestArea& area, const InterestArea* prev);
+    /// @brief Release references of the area chunks not contained in next
+    void removeArea(const InterestArea& area, const InterestArea* next);
+public:
+    ChunksInterest();
+    ~ChunksInterest();
+
+    /// @brief Synchronize areas with current players positions
+    /// @param loadDistance chunks load distance
+    /// @return true if any area has been changed or turned to other sector
+    bool update(const Players& players, int loadDistance);
+
+    const ChunkTicket* getTicket(int x, int z) const;
+
+    bool isInterested(int x, int z) const {
+        return getTicket(x, z) != nullptr;
+    }
+
+    /// @brief Get bounding box of all areas
+    /// @param min minimal chunk position (inclusive)
+    /// @param max maximal chunk position (exclusive)
+    /// @return false if there is no areas
+    bool getBounds(glm::ivec2& min, glm::ivec2& max) const;
+
+    /// @brief Get area nearest to the chunk
+    const InterestArea* getNearestArea(int x, int z) const;
+
+    const std::unordered_map<int64_t, InterestArea>& getAreas() const {
+        return areas;
+    }
+
+    const std::vector<int64_t>& getChangedAreas() const {
+        return changedAreas;
+    }
+
+    const std::vector<glm::ivec2>& getAddedTickets() const {
+        return addedTickets;
+    }
+
+    const std::unordered_map<glm::ivec2, ChunkTicket>& getTickets() const {
+        return tickets;
+    }
+
+    size_t size() const {
+        return tickets.size();
+    }
+};
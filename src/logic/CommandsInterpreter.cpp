@@ -1,6 +1,8 @@
 #include "CommandsInterpreter.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
 #include "coders/BasicParser.hpp"
@@ -34,7 +36,7 @@ class CommandParser : BasicParser<char> {
         return std::string(source.substr(start, pos - start));
     }
 
-    std::unordered_map<std::string, ArgType> types {
+    static inline const std::unordered_map<std::string, ArgType> types {
         {"num", ArgType::number},
         {"int", ArgType::integer},
         {"str", ArgType::string},
@@ -42,11 +44,32 @@ class CommandParser : BasicParser<char> {
         {"bool", ArgType::boolean},
         {"enum", ArgType::enumvalue},
     };
+
+    /// @brief Variables used by the parsed prompt
+    std::vector<PromptDependency>* dependencies = nullptr;
+
+    const dv::value& getVariable(
+        CommandsInterpreter* interpreter, const std::string& name
+    ) {
+        const auto& value = (*interpreter)[name];
+        if (dependencies) {
+            dependencies->push_back(PromptDependency {name, value});
+        }
+        return value;
+    }
 public:
     CommandParser(std::string_view filename, std::string_view source)
         : BasicParser(filename, source) {
     }
 
+    CommandParser(
+        std::string_view filename,
+        std::string_view source,
+        std::vector<PromptDependency>* dependencies
+    )
+        : BasicParser(filename, source), dependencies(dependencies) {
+    }
+
     ArgType parseType() {
         if (peek() == '[') {
             return ArgType::enumvalue;
@@ -60,9 +83,21 @@ public:
         }
     }
 
+    std::string parseSelector() {
+        int start = pos;
+        nextChar();
+        while (hasNext() && is_cmd_identifier_part(source[pos], false)) {
+            pos++;
+        }
+        return std::string(source.substr(start, pos - start));
+    }
+
     dv::value parseValue() {
         char c = peek();
-        if (is_cmd_identifier_start(c) || c == '@') {
+        if (c == '@') {
+            return parseSelector();
+        }
+        if (is_cmd_identifier_start(c)) {
             auto str = parseIdentifier(true);
             if (str == "true") {
                 return true;
@@ -113,8 +148,14 @@ public:
         expect(':');
         ArgType type = parseType();
         std::string enumname = "";
+        std::vector<std::string> enumvalues;
         if (type == ArgType::enumvalue) {
             enumname = parseEnum();
+            if (enumname[0] == '|') {
+                enumvalues = util::split(
+                    enumname.substr(1, enumname.length() - 2), '|'
+                );
+            }
         }
         bool optional = false;
         dv::value def;
@@ -143,7 +184,8 @@ public:
             optional,
             std::move(def),
             std::move(origin),
-            std::move(enumname)};
+            std::move(enumname),
+            std::move(enumvalues)};
     }
 
     Command parseScheme(executor_func executor, std::string_view description) {
@@ -200,11 +242,18 @@ public:
         return true;
     }
 
-    inline bool selectorCheck(Argument* arg, const dv::value& value) {
+    /// @brief Check selector and resolve it to object id
+    inline bool selectorCheck(Argument* arg, dv::value& value) {
         if (value.isString()) {
             const auto& string = value.asString();
             if (string[0] == '@') {
-                if (!util::is_integer(string.substr(1))) {
+                auto id = string.substr(1);
+                if (id.empty() || !util::is_integer(id)) {
+                    throw argumentError(arg->name, "invalid selector");
+                }
+                try {
+                    value = static_cast<integer_t>(std::stoll(id));
+                } catch (const std::out_of_range&) {
                     throw argumentError(arg->name, "invalid selector");
                 }
                 return true;
@@ -217,14 +266,14 @@ public:
         }
     }
 
-    bool typeCheck(Argument* arg, const dv::value& value) {
+    bool typeCheck(Argument* arg, dv::value& value) {
         switch (arg->type) {
             case ArgType::enumvalue: {
                 if (value.getType() == dv::value_type::string) {
                     const auto& string = value.asString();
-                    auto& enumname = arg->enumname;
-                    if (enumname.find("|" + string + "|") ==
-                        std::string::npos) {
+                    const auto& values = arg->enumvalues;
+                    if (std::find(values.begin(), values.end(), string) ==
+                        values.end()) {
                         throw error(
                             "argument " + util::quote(arg->name) +
                             ": invalid enumeration value"
@@ -271,7 +320,7 @@ public:
         if (dv::is_numeric(arg->origin)) {
             return dv::value(arg->origin);
         } else if (arg->origin.getType() == dv::value_type::string) {
-            return dv::value((*interpreter)[arg->origin.asString()]);
+            return getVariable(interpreter, arg->origin.asString());
         }
         return nullptr;
     }
@@ -353,7 +402,7 @@ public:
                 if (value.isString()) {
                     const auto& string = value.asString();
                     if (string[0] == '$') {
-                        value = (*interpreter)[string.substr(1)];
+                        value = getVariable(interpreter, string.substr(1));
                     }
                 }
 
@@ -361,6 +410,7 @@ public:
                 if (value.isString() && !relative && hasNext() && peek() == '=') {
                     const auto& key = value.asString();
                     kwargs[key] = performKeywordArg(interpreter, command, key);
+                    continue;
                 }
             }
 
@@ -371,7 +421,7 @@ public:
                     if (arg->def.isString()) {
                         const auto& string = arg->def.asString();
                         if (string[0] == '$') {
-                            args.add((*interpreter)[string.substr(1)]);
+                            args.add(getVariable(interpreter, string.substr(1)));
                         } else {
                             args.add(arg->def);
                         }
@@ -402,7 +452,7 @@ public:
                 if (arg->def.isString()) {
                     const auto& string = arg->def.asString();
                     if (string[0] == '$') {
-                        args.add((*interpreter)[string.substr(1)]);
+                        args.add(getVariable(interpreter, string.substr(1)));
                         continue;
                     }
                 }
@@ -429,6 +479,7 @@ void CommandsRepository::add(
 ) {
     Command command = Command::create(scheme, description, std::move(executor));
     commands[command.getName()] = command;
+    revision++;
 }
 
 Command* CommandsRepository::get(const std::string& name) {
@@ -439,6 +490,113 @@ Command* CommandsRepository::get(const std::string& name) {
     return &found->second;
 }
 
+/// @brief Compare variable values. Containers are not compared and
+/// considered changed
+static bool is_same_value(const dv::value& a, const dv::value& b) {
+    if (a.getType() != b.getType()) {
+        return false;
+    }
+    switch (a.getType()) {
+        case dv::value_type::none:
+            return true;
+        case dv::value_type::number:
+            return a.asNumber() == b.asNumber();
+        case dv::value_type::boolean:
+            return a.asBoolean() == b.asBoolean();
+        case dv::value_type::integer:
+            return a.asInteger() == b.asInteger();
+        case dv::value_type::string:
+            return a.asString() == b.asString();
+        default:
+            return false;
+    }
+}
+
+static bool is_comparable(const dv::value& value) {
+    return !value.isObject() && !value.isList() &&
+           value.getType() != dv::value_type::bytes;
+}
+
+PromptsCache::PromptsCache(size_t capacity) : capacity(capacity) {
+}
+
+const Prompt* PromptsCache::get(
+    std::string_view text,
+    size_t revision,
+    const std::unordered_map<std::string, dv::value>& variables
+) {
+    if (this->revision != revision) {
+        clear();
+        this->revision = revision;
+    }
+    const auto& found = index.find(text);
+    if (found == index.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+    auto entry = found->second;
+    for (const auto& dependency : entry->dependencies) {
+        const auto& variable = variables.find(dependency.name);
+        if (variable == variables.end() ||
+            !is_same_value(variable->second, dependency.value)) {
+            stats.misses++;
+            return nullptr;
+        }
+    }
+    entries.splice(entries.begin(), entries, entry);
+    stats.hits++;
+    return &entry->prompt;
+}
+
+void PromptsCache::put(
+    std::string_view text,
+    const Prompt& prompt,
+    std::vector<PromptDependency> dependencies
+) {
+    for (const auto& dependency : dependencies) {
+        if (!is_comparable(dependency.value)) {
+            return;
+        }
+    }
+    const auto& found = index.find(text);
+    if (found != index.end()) {
+        auto entry = found->second;
+        entry->prompt = prompt;
+        entry->dependencies = std::move(dependencies);
+        entries.splice(entries.begin(), entries, entry);
+        return;
+    }
+    if (entries.size() >= capacity) {
+        index.erase(entries.back().text);
+        entries.pop_back();
+    }
+    entries.push_front(
+        Entry {std::string(text), prompt, std::move(dependencies)}
+    );
+    index[entries.front().text] = entries.begin();
+}
+
+void PromptsCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+size_t PromptsCache::size() const {
+    return entries.size();
+}
+
+const PromptsCacheStats& PromptsCache::getStats() const {
+    return stats;
+}
+
 Prompt CommandsInterpreter::parse(std::string_view text) {
-    return CommandParser("[string]", text).parsePrompt(this);
+    size_t revision = repository->getRevision();
+    if (auto prompt = cache.get(text, revision, variables)) {
+        return *prompt;
+    }
+    std::vector<PromptDependency> dependencies;
+    auto prompt = CommandParser("[string]", text, &dependencies)
+        .parsePrompt(this);
+    cache.put(text, prompt, std::move(dependencies));
+    return prompt;
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <functional>
+#include <list>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -36,6 +39,8 @@ namespace cmd {
         dv::value def;
         dv::value origin;
         std::string enumname;
+        /// @brief Enumeration values split once on scheme parsing
+        std::vector<std::string> enumvalues;
     };
 
     class Command;
@@ -47,6 +52,58 @@ namespace cmd {
         dv::value kwargs;  // keyword arguments table
     };
 
+    /// @brief Variable value used while parsing a prompt
+    struct PromptDependency {
+        std::string name;
+        dv::value value;
+    };
+
+    struct PromptsCacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    /// @brief Bounded LRU cache of parsed prompts keyed by input text.
+    /// Prompt is reused while used variables keep the same values
+    class PromptsCache {
+        struct Entry {
+            std::string text;
+            Prompt prompt;
+            std::vector<PromptDependency> dependencies;
+        };
+        size_t capacity;
+        /// @brief Commands repository revision the entries are parsed with
+        size_t revision = 0;
+        std::list<Entry> entries;
+        std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+        PromptsCacheStats stats {};
+    public:
+        PromptsCache(size_t capacity);
+
+        /// @brief Find valid cached prompt
+        /// @param text input text
+        /// @param revision current commands repository revision
+        /// @param variables current interpreter variables
+        /// @return cached prompt or nullptr
+        const Prompt* get(
+            std::string_view text,
+            size_t revision,
+            const std::unordered_map<std::string, dv::value>& variables
+        );
+
+        void put(
+            std::string_view text,
+            const Prompt& prompt,
+            std::vector<PromptDependency> dependencies
+        );
+
+        void clear();
+
+        size_t size() const;
+
+        const PromptsCacheStats& getStats() const;
+    };
+
     using executor_func = std::function<dv::value(
         CommandsInterpreter*, const dv::value& args, const dv::value& kwargs
     )>;
@@ -116,6 +173,8 @@ namespace cmd {
 
     class CommandsRepository {
         std::unordered_map<std::string, Command> commands;
+        /// @brief Incremented on every change, invalidating parsed prompts
+        size_t revision = 0;
     public:
         void add(
             std::string_view scheme, std::string_view description, executor_func
@@ -126,15 +185,23 @@ namespace cmd {
             return commands;
         }
 
+        size_t getRevision() const {
+            return revision;
+        }
+
         void clear() {
             commands.clear();
+            revision++;
         }
     };
 
     class CommandsInterpreter {
         std::unique_ptr<CommandsRepository> repository;
         std::unordered_map<std::string, dv::value> variables;
+        PromptsCache cache {PROMPTS_CACHE_CAPACITY};
     public:
+        static constexpr size_t PROMPTS_CACHE_CAPACITY = 256;
+
         CommandsInterpreter()
             : repository(std::make_unique<CommandsRepository>()) {
         }
@@ -145,6 +212,7 @@ namespace cmd {
             : repository(std::move(repository)) {
         }
 
+        /// @brief Parse prompt or get it from the parsed prompts cache
         Prompt parse(std::string_view text);
 
         dv::value execute(std::string_view input) {
@@ -163,6 +231,10 @@ namespace cmd {
             return repository.get();
         }
 
+        const PromptsCache& getCache() const {
+            return cache;
+        }
+
         void reset() {
             repository->clear();
             variables.clear();
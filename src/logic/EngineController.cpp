@@ -250,6 +250,25 @@ void EngineController::openWorld(const std::string& name, bool confirmConvert) {
     });
 }
 
+void EngineController::recompressWorld(const std::string& name) {
+    const auto& paths = engine.getPaths();
+    auto folder = paths.getWorldsFolder() / name;
+    check_world(paths, folder);
+
+    auto worldFiles = std::make_shared<WorldFiles>(
+        folder, engine.getSettings().debug
+    );
+    auto task = WorldConverter::startTask(
+        worldFiles,
+        nullptr,
+        nullptr,
+        []() {},
+        ConvertMode::RECOMPRESS,
+        true
+    );
+    start(engine, std::move(task), L"Recompressing world...");
+}
+
 inline uint64_t str2seed(const std::string& seedstr) {
     if (util::is_integer(seedstr)) {
         try {
@@ -22,6 +22,11 @@ public:
     /// @param confirmConvert automatically confirm convert if requested
     void openWorld(const std::string& name, bool confirmConvert);
 
+    /// @brief Convert world region files stored with other compression
+    /// methods to the current ones
+    /// @param name world name
+    void recompressWorld(const std::string& name);
+
     /// @brief Show world removal confirmation dialog
     /// @param name world name
     void deleteWorld(const std::string& name);
@@ -5,6 +5,7 @@
 #include "debug/Logger.hpp"
 #include "engine/Engine.hpp"
 #include "world/files/WorldFiles.hpp"
+#include "world/files/WorldBackup.hpp"
 #include "maths/voxmaths.hpp"
 #include "objects/Entities.hpp"
 #include "objects/Players.hpp"
@@ -14,12 +15,19 @@
 #include "scripting/scripting.hpp"
 #include "lighting/Lighting.hpp"
 #include "settings.hpp"
+#include "util/timeutil.hpp"
 #include "world/LevelEvents.hpp"
 #include "world/Level.hpp"
 #include "world/World.hpp"
 
 static debug::Logger logger("level-control");
 
+static constexpr float OVERRUNS_REPORT_INTERVAL = 5.0f;
+
+static const char* TICK_PHASE_NAMES[TICK_PHASES_COUNT] {
+    "chunks", "blocks", "physics", "entities", "players"
+};
+
 LevelController::LevelController(
     Engine* engine, std::unique_ptr<Level> levelPtr, Player* clientPlayer
 )
@@ -41,7 +49,7 @@ LevelController::LevelController(
         );
     }
     blocks = std::make_unique<BlocksController>(
-        *level, chunks ? chunks->lighting.get() : nullptr
+        *level, chunks->getInterest(), chunks->lighting.get()
     );
     scripting::on_world_load(this);
 
@@ -51,15 +59,18 @@ LevelController::LevelController(
         confirmed = 0;
         for (const auto& [_, player] : *level->players) {
             if (!player->isLoadingChunks()) {
-                confirmed++;
                 continue;
             }
             glm::vec3 position = player->getPosition();
             player->chunks->configure(
                 std::floor(position.x), std::floor(position.z), 1
             );
-            chunks->update(16, 1, 0, *player);
-            if (player->chunks->get(
+        }
+        chunks->update(16, 1);
+        for (const auto& [_, player] : *level->players) {
+            glm::vec3 position = player->getPosition();
+            if (!player->isLoadingChunks() || player->isSuspended() ||
+                player->chunks->get(
                     std::floor(position.x), 0, std::floor(position.z)
                 )) {
                 confirmed++;
@@ -81,41 +92,108 @@ void LevelController::update(float delta, bool pause) {
             glm::floor(position.z),
             settings.chunks.loadDistance.get() + settings.chunks.padding.get()
         );
+    }
+    timeutil::Timer timer;
+    if (!reducedWork) {
         chunks->update(
-            settings.chunks.loadSpeed.get(),
-            settings.chunks.loadDistance.get(),
-            settings.chunks.padding.get(),
-            *player
+            getBudget(TickPhase::CHUNKS), settings.chunks.loadDistance.get()
         );
+        finishPhase(TickPhase::CHUNKS, timer.stop());
     }
     if (!pause) {
         // update all objects that needed
-        blocks->update(delta, settings.chunks.padding.get());
+        timer = {};
+        blocks->setUpdatesLimit(settings.tick.blockUpdatesLimit.get());
+        blocks->update(delta, reducedWork ? 0 : getBudget(TickPhase::BLOCKS));
+        finishPhase(TickPhase::BLOCKS, timer.stop());
+
+        timer = {};
         level->entities->updatePhysics(delta);
+        finishPhase(TickPhase::PHYSICS, timer.stop());
+
+        timer = {};
         level->entities->update(delta);
-        for (const auto& [_, player] : *level->players) {
-            if (player->isSuspended()) {
-                continue;
-            }
-            if (playerTickClock.update(delta)) {
-                if (player->getId() % playerTickClock.getParts() ==
-                    playerTickClock.getPart()) {
-                    
-                    const auto& position = player->getPosition();
-                    if (player->chunks->get(
-                        std::floor(position.x),
-                        std::floor(position.y),
-                        std::floor(position.z)
-                    )){
-                        scripting::on_player_tick(
-                            player.get(), playerTickClock.getTickRate()
-                        );
-                    }
+        finishPhase(TickPhase::ENTITIES, timer.stop());
+
+        timer = {};
+        updatePlayers(delta);
+        finishPhase(TickPhase::PLAYERS, timer.stop());
+    }
+    level->entities->clean();
+    reportOverruns(delta);
+}
+
+void LevelController::updatePlayers(float delta) {
+    for (const auto& [_, player] : *level->players) {
+        if (player->isSuspended()) {
+            continue;
+        }
+        if (playerTickClock.update(delta)) {
+            if (player->getId() % playerTickClock.getParts() ==
+                playerTickClock.getPart()) {
+                
+                const auto& position = player->getPosition();
+                if (player->chunks->get(
+                    std::floor(position.x),
+                    std::floor(position.y),
+                    std::floor(position.z)
+                )){
+                    scripting::on_player_tick(
+                        player.get(), playerTickClock.getTickRate()
+                    );
                 }
             }
         }
     }
-    level->entities->clean();
+}
+
+int64_t LevelController::getBudget(TickPhase phase) const {
+    switch (phase) {
+        case TickPhase::CHUNKS:
+            return settings.chunks.loadSpeed.get();
+        case TickPhase::BLOCKS:
+            return settings.tick.blocksBudget.get();
+        case TickPhase::PHYSICS:
+            return settings.tick.physicsBudget.get();
+        case TickPhase::ENTITIES:
+            return settings.tick.entitiesBudget.get();
+        case TickPhase::PLAYERS:
+            return settings.tick.playersBudget.get();
+    }
+    return 0;
+}
+
+void LevelController::finishPhase(TickPhase phase, int64_t time) {
+    auto& stats = phasesStats[static_cast<size_t>(phase)];
+    stats.lastTime = time;
+    stats.maxTime = std::max(stats.maxTime, time);
+    if (time > getBudget(phase) * 1000) {
+        stats.overruns++;
+    }
+}
+
+void LevelController::reportOverruns(float delta) {
+    overrunsReportTimer += delta;
+    if (overrunsReportTimer < OVERRUNS_REPORT_INTERVAL) {
+        return;
+    }
+    overrunsReportTimer = 0.0f;
+    for (size_t i = 0; i < TICK_PHASES_COUNT; i++) {
+        auto& stats = phasesStats[i];
+        if (stats.overruns) {
+            logger.warning() << "tick phase '" << TICK_PHASE_NAMES[i]
+                             << "' exceeded budget " << stats.overruns
+                             << " times (max " << stats.maxTime / 1000.0
+                             << " ms, budget "
+                             << getBudget(static_cast<TickPhase>(i)) << " ms)";
+        }
+        stats.maxTime = 0;
+        stats.overruns = 0;
+    }
+}
+
+void LevelController::setReducedWork(bool flag) {
+    reducedWork = flag;
 }
 
 void LevelController::saveWorld() {
@@ -131,6 +209,27 @@ void LevelController::saveWorld() {
     level->getWorld()->write(level.get());
 }
 
+std::shared_ptr<WorldBackup> LevelController::backupWorld(
+    const io::path& destination, bool hardlinks
+) {
+    auto world = level->getWorld();
+    if (world->isNameless()) {
+        throw std::runtime_error("nameless world could not be backed up");
+    }
+    timeutil::Timer timer;
+    saveWorld();
+    auto backup = world->wfile->createBackup(destination, hardlinks);
+    double stallTime = timer.stop() / 1000.0;
+    backup->setStallTime(stallTime);
+
+    auto stats = backup->getStats();
+    logger.info() << "backup " << destination.string() << " captured in "
+                  << stallTime << " ms (" << stats.bytesCopied
+                  << " bytes copied, " << stats.bytesLinked
+                  << " bytes hard-linked)";
+    return backup;
+}
+
 void LevelController::onWorldQuit() {
     scripting::on_world_quit();
 }
@@ -146,3 +245,7 @@ BlocksController* LevelController::getBlocksController() {
 ChunksController* LevelController::getChunksController() {
     return chunks.get();
 }
+
+const TickPhaseStats& LevelController::getPhaseStats(TickPhase phase) const {
+    return phasesStats[static_cast<size_t>(phase)];
+}
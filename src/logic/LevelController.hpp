@@ -1,16 +1,33 @@
 #pragma once
 
+#include <array>
 #include <memory>
 
 #include "BlocksController.hpp"
 #include "ChunksController.hpp"
+#include "io/path.hpp"
 #include "util/Clock.hpp"
 
 class Engine;
 class Level;
 class Player;
+class WorldBackup;
 struct EngineSettings;
 
+enum class TickPhase { CHUNKS, BLOCKS, PHYSICS, ENTITIES, PLAYERS };
+
+inline constexpr size_t TICK_PHASES_COUNT = 5;
+
+/// @brief Level update phase time accounting
+struct TickPhaseStats {
+    /// @brief Last update duration (microseconds)
+    int64_t lastTime = 0;
+    /// @brief Max update duration since the last report (microseconds)
+    int64_t maxTime = 0;
+    /// @brief Budget overruns since the last report
+    int overruns = 0;
+};
+
 /// @brief LevelController manages other controllers
 class LevelController {
     EngineSettings& settings;
@@ -20,6 +37,17 @@ class LevelController {
     std::unique_ptr<ChunksController> chunks;
 
     util::Clock playerTickClock;
+
+    std::array<TickPhaseStats, TICK_PHASES_COUNT> phasesStats {};
+    float overrunsReportTimer = 0.0f;
+    bool reducedWork = false;
+
+    /// @return phase time budget in milliseconds
+    int64_t getBudget(TickPhase phase) const;
+    void finishPhase(TickPhase phase, int64_t time);
+    /// @brief Log overrun phases periodically
+    void reportOverruns(float delta);
+    void updatePlayers(float delta);
 public:
     LevelController(Engine* engine, std::unique_ptr<Level> level, Player* clientPlayer);
 
@@ -27,12 +55,26 @@ public:
     /// @param pause is world and player simulation paused
     void update(float delta, bool pause);
 
+    /// @brief Reduced work mode is used for catch-up ticks: chunks are not
+    /// loaded and deferrable work takes minimal time
+    void setReducedWork(bool flag);
+
     void saveWorld();
 
+    /// @brief Save world and capture its backup. The world is stalled only
+    /// while dirty data is written and the snapshot is captured
+    /// @param destination backup directory
+    /// @param hardlinks try to hard-link region files instead of copying
+    std::shared_ptr<WorldBackup> backupWorld(
+        const io::path& destination, bool hardlinks
+    );
+
     void onWorldQuit();
 
     Level* getLevel();
 
     BlocksController* getBlocksController();
     ChunksController* getChunksController();
+
+    const TickPhaseStats& getPhaseStats(TickPhase phase) const;
 };
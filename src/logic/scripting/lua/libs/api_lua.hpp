@@ -27,6 +27,7 @@ extern const luaL_Reg consolelib[];
 extern const luaL_Reg corelib[];
 extern const luaL_Reg entitylib[];
 extern const luaL_Reg filelib[];
+extern const luaL_Reg filereadlib[]; // read-only file for worker states
 extern const luaL_Reg generationlib[];
 extern const luaL_Reg guilib[];
 extern const luaL_Reg hudlib[];
@@ -49,6 +50,7 @@ extern const luaL_Reg vec2lib[];  // vecn.cpp
 extern const luaL_Reg vec3lib[];  // vecn.cpp
 extern const luaL_Reg vec4lib[];  // vecn.cpp
 extern const luaL_Reg weatherlib[]; // gfx.weather
+extern const luaL_Reg workerslib[];
 extern const luaL_Reg worldlib[];
 extern const luaL_Reg yamllib[];
 
@@ -14,6 +14,7 @@
 #include "voxels/blocks_agent.hpp"
 #include "world/Level.hpp"
 #include "maths/voxmaths.hpp"
+#include "util/stringutil.hpp"
 #include "data/StructLayout.hpp"
 #include "engine/Engine.hpp"
 #include "api_lua.hpp"
@@ -49,6 +50,29 @@ static int l_is_solid_at(lua::State* L) {
     );
 }
 
+static int l_get_height(lua::State* L) {
+    auto x = lua::tointeger(L, 1);
+    auto z = lua::tointeger(L, 2);
+    auto type = HeightmapType::NON_AIR;
+    if (lua::isstring(L, 3)) {
+        auto name = lua::require_string(L, 3);
+        if (!HeightmapTypeMeta.getItem(name, type)) {
+            throw std::runtime_error(
+                "unknown heightmap type " + util::quote(name)
+            );
+        }
+    }
+    int cx = floordiv<CHUNK_W>(x);
+    int cz = floordiv<CHUNK_D>(z);
+    auto chunk = blocks_agent::get_chunk(*level->chunks, cx, cz);
+    if (chunk == nullptr) {
+        return lua::pushinteger(L, -1);
+    }
+    return lua::pushinteger(
+        L, chunk->heights.get(type, x - cx * CHUNK_W, z - cz * CHUNK_D)
+    );
+}
+
 static int l_count(lua::State* L) {
     return lua::pushinteger(L, indices->blocks.count());
 }
@@ -106,6 +130,15 @@ static int l_set(lua::State* L) {
     if (!blocks_agent::get_chunk(*level->chunks, cx, cz)) {
         return 0;
     }
+    if (auto batch = blocks->getEditBatch()) {
+        blocks_agent::set(
+            *level->chunks, x, y, z, id, int2blockstate(state), *batch
+        );
+        if (!noupdate) {
+            batch->notified.emplace_back(x, y, z);
+        }
+        return 0;
+    }
     blocks_agent::set(*level->chunks, x, y, z, id, int2blockstate(state));
 
     auto chunksController = controller->getChunksController();
@@ -122,6 +155,35 @@ static int l_set(lua::State* L) {
     return 0;
 }
 
+static int l_begin_edit(lua::State* L) {
+    if (blocks == nullptr) {
+        throw std::runtime_error("no world open");
+    }
+    if (!blocks->beginEdit()) {
+        throw std::runtime_error("blocks edit is already in progress");
+    }
+    return 0;
+}
+
+static int l_commit_edit(lua::State* L) {
+    if (blocks == nullptr) {
+        throw std::runtime_error("no world open");
+    }
+    return lua::pushinteger(L, blocks->commitEdit());
+}
+
+static int l_schedule_update(lua::State* L) {
+    if (blocks == nullptr) {
+        throw std::runtime_error("no world open");
+    }
+    auto x = lua::tointeger(L, 1);
+    auto y = lua::tointeger(L, 2);
+    auto z = lua::tointeger(L, 3);
+    auto delay = lua::tointeger(L, 4);
+    blocks->scheduleUpdate(x, y, z, delay);
+    return 0;
+}
+
 static int l_get(lua::State* L) {
     auto x = lua::tointeger(L, 1);
     auto y = lua::tointeger(L, 2);
@@ -201,6 +263,24 @@ static int l_get_states(lua::State* L) {
     return lua::pushinteger(L, states);
 }
 
+static int l_get_light(lua::State* L) {
+    auto x = lua::tointeger(L, 1);
+    auto y = lua::tointeger(L, 2);
+    auto z = lua::tointeger(L, 3);
+    if (y < 0 || y >= CHUNK_H) {
+        return lua::pushinteger(L, -1);
+    }
+    int cx = floordiv<CHUNK_W>(x);
+    int cz = floordiv<CHUNK_D>(z);
+    auto chunk = blocks_agent::get_chunk(*level->chunks, cx, cz);
+    if (chunk == nullptr) {
+        return lua::pushinteger(L, -1);
+    }
+    int lx = x - cx * CHUNK_W;
+    int lz = z - cz * CHUNK_D;
+    return lua::pushinteger(L, chunk->lightmap.get(lx, y, lz));
+}
+
 static int l_set_states(lua::State* L) {
     auto x = lua::tointeger(L, 1);
     auto y = lua::tointeger(L, 2);
@@ -685,6 +765,9 @@ static int l_reload_script(lua::State* L) {
     auto& writeableContent = *content_control->get();
     auto& def = writeableContent.blocks.require(name);
     ContentLoader::reloadScript(writeableContent, def);
+    if (blocks) {
+        blocks->indexHandlers();
+    }
     return 0;
 }
 
@@ -696,12 +779,17 @@ const luaL_Reg blocklib[] = {
     {"defs_count", lua::wrap<l_count>},
     {"is_solid_at", lua::wrap<l_is_solid_at>},
     {"is_replaceable_at", lua::wrap<l_is_replaceable_at>},
+    {"get_height", lua::wrap<l_get_height>},
     {"set", lua::wrap<l_set>},
     {"get", lua::wrap<l_get>},
+    {"begin_edit", lua::wrap<l_begin_edit>},
+    {"commit_edit", lua::wrap<l_commit_edit>},
+    {"schedule_update", lua::wrap<l_schedule_update>},
     {"get_X", lua::wrap<l_get_x>},
     {"get_Y", lua::wrap<l_get_y>},
     {"get_Z", lua::wrap<l_get_z>},
     {"get_states", lua::wrap<l_get_states>},
+    {"get_light", lua::wrap<l_get_light>},
     {"set_states", lua::wrap<l_set_states>},
     {"get_rotation", lua::wrap<l_get_rotation>},
     {"set_rotation", lua::wrap<l_set_rotation>},
@@ -122,6 +122,18 @@ static int l_delete_world(lua::State* L) {
     return 0;
 }
 
+/// @brief Convert world region files to the current compression methods
+/// @param name Name world
+static int l_recompress_world(lua::State* L) {
+    auto name = lua::require_string(L, 1);
+    if (level != nullptr) {
+        throw std::runtime_error("world must be closed before");
+    }
+    auto controller = engine->getController();
+    controller->recompressWorld(name);
+    return 0;
+}
+
 /// @brief Reconfigure packs
 /// @param addPacks An array of packs to add
 /// @param remPacks An array of packs to remove
@@ -278,6 +290,7 @@ const luaL_Reg corelib[] = {
     {"save_world", lua::wrap<l_save_world>},
     {"close_world", lua::wrap<l_close_world>},
     {"delete_world", lua::wrap<l_delete_world>},
+    {"recompress_world", lua::wrap<l_recompress_world>},
     {"reconfig_packs", lua::wrap<l_reconfig_packs>},
     {"get_setting", lua::wrap<l_get_setting>},
     {"set_setting", lua::wrap<l_set_setting>},
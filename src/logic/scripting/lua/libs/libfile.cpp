@@ -285,3 +285,12 @@ const luaL_Reg filelib[] = {
     {"create_zip", lua::wrap<l_create_zip>},
     {NULL, NULL}
 };
+
+const luaL_Reg filereadlib[] = {
+    {"exists", lua::wrap<l_exists>},
+    {"isdir", lua::wrap<l_isdir>},
+    {"isfile", lua::wrap<l_isfile>},
+    {"length", lua::wrap<l_length>},
+    {"read", lua::wrap<l_read>},
+    {NULL, NULL}
+};
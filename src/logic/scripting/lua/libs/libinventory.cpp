@@ -52,9 +52,21 @@ namespace {
         auto& item = inv.getSlot(slotid);
         return func(L, item);
     }
+
+    using ConstSlotFunc = int(lua::State*, const ItemStack&);
+
+    /// @brief Read-only slot access keeping the inventory encoded cache valid
+    template <ConstSlotFunc func>
+    int wrap_const_slot(lua::State* L) {
+        auto invid = lua::tointeger(L, 1);
+        auto slotid = lua::tointeger(L, 2);
+        const auto& inv = get_inventory(invid);
+        validate_slotid(slotid, inv);
+        return func(L, inv.getSlot(slotid));
+    }
 }
 
-static int l_get(lua::State* L, ItemStack& item) {
+static int l_get(lua::State* L, const ItemStack& item) {
     lua::pushinteger(L, item.getItemId());
     lua::pushinteger(L, item.getCount());
     return 2;
@@ -203,7 +215,7 @@ static int l_find_by_item(lua::State* L) {
     return lua::pushinteger(L, index);
 }
 
-static int l_get_data(lua::State* L, ItemStack& stack) {
+static int l_get_data(lua::State* L, const ItemStack& stack) {
     auto key = lua::require_string(L, 3);
     auto value = stack.getField(key);
     if (value == nullptr) {
@@ -212,11 +224,11 @@ static int l_get_data(lua::State* L, ItemStack& stack) {
     return lua::pushvalue(L, *value);
 }
 
-static int l_get_all_data(lua::State* L, ItemStack& stack) {
+static int l_get_all_data(lua::State* L, const ItemStack& stack) {
     return lua::pushvalue(L, stack.getFields());
 }
 
-static int l_has_data(lua::State* L, ItemStack& stack) {
+static int l_has_data(lua::State* L, const ItemStack& stack) {
     auto key = lua::tostring(L, 3);
     if (key == nullptr) {
         return lua::pushboolean(L, stack.hasFields());
@@ -232,7 +244,7 @@ static int l_set_data(lua::State* L, ItemStack& stack) {
 }
 
 const luaL_Reg inventorylib[] = {
-    {"get", lua::wrap<wrap_slot<l_get>>},
+    {"get", lua::wrap<wrap_const_slot<l_get>>},
     {"set", lua::wrap<wrap_slot<l_set>>},
     {"set_count", lua::wrap<wrap_slot<l_set_count>>},
     {"size", lua::wrap<l_size>},
@@ -243,10 +255,10 @@ const luaL_Reg inventorylib[] = {
     {"get_block", lua::wrap<l_get_block>},
     {"bind_block", lua::wrap<l_bind_block>},
     {"unbind_block", lua::wrap<l_unbind_block>},
-    {"get_data", lua::wrap<wrap_slot<l_get_data>>},
+    {"get_data", lua::wrap<wrap_const_slot<l_get_data>>},
     {"set_data", lua::wrap<wrap_slot<l_set_data>>},
-    {"get_all_data", lua::wrap<wrap_slot<l_get_all_data>>},
-    {"has_data", lua::wrap<wrap_slot<l_has_data>>},
+    {"get_all_data", lua::wrap<wrap_const_slot<l_get_all_data>>},
+    {"has_data", lua::wrap<wrap_const_slot<l_has_data>>},
     {"create", lua::wrap<l_create>},
     {"remove", lua::wrap<l_remove>},
     {"clone", lua::wrap<l_clone>},
@@ -42,7 +42,7 @@ static int l_determinant(lua::State* L) {
 static int l_mul(lua::State* L) {
     uint argc = lua::check_argc(L, 2, 3);
     auto matrix1 = lua::tomat4(L, 1);
-    uint len2 = lua::objlen(L, 2);
+    uint len2 = lua::veclen(L, 2);
     if (len2 < 3) {
         throw std::runtime_error("argument #2: vec3 or vec4 expected");
     }
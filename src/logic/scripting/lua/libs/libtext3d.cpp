@@ -33,8 +33,10 @@ static int l_get_text(lua::State* L) {
 }
 
 static int l_set_text(lua::State* L) {
-    if (auto note = renderer->texts->get(lua::tointeger(L, 1))) {
+    auto id = lua::tointeger(L, 1);
+    if (auto note = renderer->texts->get(id)) {
         note->setText(lua::require_wstring(L, 2));
+        renderer->texts->update(id);
     }
     return 0;
 }
@@ -46,8 +48,10 @@ static int l_get_pos(lua::State* L) {
     return 0;
 }
 static int l_set_pos(lua::State* L) {
-    if (auto note = renderer->texts->get(lua::tointeger(L, 1))) {
+    auto id = lua::tointeger(L, 1);
+    if (auto note = renderer->texts->get(id)) {
         note->setPosition(lua::tovec3(L, 2));
+        renderer->texts->update(id);
     }
     return 0;
 }
@@ -59,8 +63,10 @@ static int l_get_axis_x(lua::State* L) {
     return 0;
 }
 static int l_set_axis_x(lua::State* L) {
-    if (auto note = renderer->texts->get(lua::tointeger(L, 1))) {
+    auto id = lua::tointeger(L, 1);
+    if (auto note = renderer->texts->get(id)) {
         note->setAxisX(lua::tovec3(L, 2));
+        renderer->texts->update(id);
     }
     return 0;
 }
@@ -73,24 +79,30 @@ static int l_get_axis_y(lua::State* L) {
     return 0;
 }
 static int l_set_axis_y(lua::State* L) {
-    if (auto note = renderer->texts->get(lua::tointeger(L, 1))) {
+    auto id = lua::tointeger(L, 1);
+    if (auto note = renderer->texts->get(id)) {
         note->setAxisY(lua::tovec3(L, 2));
+        renderer->texts->update(id);
     }
     return 0;
 }
 
 static int l_update_settings(lua::State* L) {
-    if (auto note = renderer->texts->get(lua::tointeger(L, 1))) {
+    auto id = lua::tointeger(L, 1);
+    if (auto note = renderer->texts->get(id)) {
         note->updatePreset(lua::tovalue(L, 2));
+        renderer->texts->update(id);
     }
     return 0;
 }
 
 static int l_set_rotation(lua::State* L) {
-    if (auto note = renderer->texts->get(lua::tointeger(L, 1))) {
+    auto id = lua::tointeger(L, 1);
+    if (auto note = renderer->texts->get(id)) {
         auto matrix = lua::tomat4(L, 2);
         note->setAxisX(matrix * glm::vec4(1, 0, 0, 1));
         note->setAxisY(matrix * glm::vec4(0, 1, 0, 1));
+        renderer->texts->update(id);
     }
     return 0;
 }
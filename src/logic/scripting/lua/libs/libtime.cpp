@@ -11,8 +11,18 @@ static int l_delta(lua::State* L) {
     return lua::pushnumber(L, engine->getTime().getDelta());
 }
 
+static int l_mspt(lua::State* L) {
+    return lua::pushnumber(L, engine->getTime().getMSPT());
+}
+
+static int l_tps(lua::State* L) {
+    return lua::pushnumber(L, engine->getTime().getTPS());
+}
+
 const luaL_Reg timelib[] = {
     {"uptime", lua::wrap<l_uptime>},
     {"delta", lua::wrap<l_delta>},
+    {"mspt", lua::wrap<l_mspt>},
+    {"tps", lua::wrap<l_tps>},
     {NULL, NULL}
 };
@@ -0,0 +1,24 @@
+#include "api_lua.hpp"
+
+#include "logic/scripting/scripting.hpp"
+
+using namespace scripting;
+
+/// workers.submit(module: str, func: str, args: any, [callback: function])
+static int l_submit(lua::State* L) {
+    auto module = lua::require_string(L, 1);
+    auto function = lua::require_string(L, 2);
+    auto args = lua::tovalue(L, 3);
+    common_func callback = nullptr;
+    if (lua::isfunction(L, 4)) {
+        lua::pushvalue(L, 4);
+        callback = lua::create_lambda_nothrow(L);
+    }
+    scripting::submit_job(module, function, std::move(args), callback);
+    return 0;
+}
+
+const luaL_Reg workerslib[] = {
+    {"submit", lua::wrap<l_submit>},
+    {NULL, NULL}
+};
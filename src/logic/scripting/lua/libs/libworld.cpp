@@ -9,6 +9,7 @@
 #include "content/ContentLoader.hpp"
 #include "content/ContentControl.hpp"
 #include "engine/Engine.hpp"
+#include "world/files/WorldBackup.hpp"
 #include "world/files/WorldFiles.hpp"
 #include "io/engine_paths.hpp"
 #include "io/io.hpp"
@@ -222,6 +223,21 @@ static int l_count_chunks(lua::State* L) {
     return lua::pushinteger(L, level->chunks->size());
 }
 
+static int l_backup(lua::State* L) {
+    if (controller == nullptr) {
+        throw std::runtime_error("no world open");
+    }
+    bool hardlinks = lua::isnoneornil(L, 1) || lua::toboolean(L, 1);
+    auto destination = engine->getPaths().getNewBackupFolder(
+        level->getWorld()->getName()
+    );
+    auto backup = controller->backupWorld(destination, hardlinks);
+    auto stats = backup->getStats();
+    lua::pushstring(L, destination.string());
+    lua::pushnumber(L, stats.stallTime);
+    return 2;
+}
+
 static int l_reload_script(lua::State* L) {
     auto packid = lua::require_string(L, 1);
     if (content == nullptr) {
@@ -251,5 +267,6 @@ const luaL_Reg worldlib[] = {
     {"save_chunk_data", lua::wrap<l_save_chunk_data>},
     {"count_chunks", lua::wrap<l_count_chunks>},
     {"reload_script", lua::wrap<l_reload_script>},
+    {"backup", lua::wrap<l_backup>},
     {NULL, NULL}
 };
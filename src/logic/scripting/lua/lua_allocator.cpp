@@ -0,0 +1,101 @@
+#include "lua_allocator.hpp"
+
+#include <new>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+using namespace lua;
+
+Allocator::Allocator() = default;
+
+Allocator::~Allocator() = default;
+
+void* Allocator::allocatePooled(size_t sizeClass) {
+    if (auto block = freeLists[sizeClass]) {
+        freeLists[sizeClass] = block->next;
+        return block;
+    }
+    size_t blockSize = (sizeClass + 1) * SIZE_CLASS_STEP;
+    if (pageLeft < blockSize) {
+        // page tail is lost, it's smaller than the largest class
+        auto page = std::unique_ptr<uint8_t[]>(new (std::nothrow)
+                                                   uint8_t[PAGE_SIZE]);
+        if (page == nullptr) {
+            return nullptr;
+        }
+        pageCursor = page.get();
+        pageLeft = PAGE_SIZE;
+        pages.push_back(std::move(page));
+    }
+    void* ptr = pageCursor;
+    pageCursor += blockSize;
+    pageLeft -= blockSize;
+    return ptr;
+}
+
+void* Allocator::allocate(size_t size) {
+    void* ptr;
+    if (size <= MAX_POOLED_SIZE) {
+        ptr = allocatePooled(get_size_class(size));
+    } else {
+        ptr = std::malloc(size);
+    }
+    if (ptr) {
+        usedBytes += size;
+        peakBytes = std::max(peakBytes, usedBytes);
+    }
+    return ptr;
+}
+
+void Allocator::deallocate(void* ptr, size_t size) {
+    if (ptr == nullptr) {
+        return;
+    }
+    usedBytes -= size;
+    if (size <= MAX_POOLED_SIZE) {
+        auto block = reinterpret_cast<FreeBlock*>(ptr);
+        size_t sizeClass = get_size_class(size);
+        block->next = freeLists[sizeClass];
+        freeLists[sizeClass] = block;
+    } else {
+        std::free(ptr);
+    }
+}
+
+void* Allocator::reallocate(void* ptr, size_t osize, size_t nsize) {
+    if (nsize == 0) {
+        deallocate(ptr, osize);
+        return nullptr;
+    }
+    if (ptr == nullptr) {
+        return allocate(nsize);
+    }
+    bool pooledBefore = osize <= MAX_POOLED_SIZE;
+    bool pooledAfter = nsize <= MAX_POOLED_SIZE;
+    if (pooledBefore && pooledAfter &&
+        get_size_class(osize) == get_size_class(nsize)) {
+        usedBytes = usedBytes - osize + nsize;
+        peakBytes = std::max(peakBytes, usedBytes);
+        return ptr;
+    }
+    if (!pooledBefore && !pooledAfter) {
+        void* newptr = std::realloc(ptr, nsize);
+        if (newptr) {
+            usedBytes = usedBytes - osize + nsize;
+            peakBytes = std::max(peakBytes, usedBytes);
+        }
+        return newptr;
+    }
+    void* newptr = allocate(nsize);
+    if (newptr == nullptr) {
+        return nullptr;
+    }
+    std::memcpy(newptr, ptr, std::min(osize, nsize));
+    deallocate(ptr, osize);
+    return newptr;
+}
+
+void* Allocator::alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    return reinterpret_cast<Allocator*>(ud)->reallocate(ptr, osize, nsize);
+}
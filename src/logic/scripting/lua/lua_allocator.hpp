@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace lua {
+    /// @brief Lua state allocator. Small blocks are taken from size-class
+    /// free lists carved out of large pages, so short-lived tables and
+    /// strings do not hit the system allocator. Keeps memory accounting.
+    /// @attention not thread-safe, one allocator per Lua state
+    class Allocator {
+    public:
+        static constexpr size_t SIZE_CLASS_STEP = 16;
+        static constexpr size_t MAX_POOLED_SIZE = 512;
+        static constexpr size_t PAGE_SIZE = 64 * 1024;
+
+        Allocator();
+        ~Allocator();
+
+        Allocator(const Allocator&) = delete;
+        Allocator& operator=(const Allocator&) = delete;
+
+        /// @return nullptr if out of memory
+        void* allocate(size_t size);
+        void deallocate(void* ptr, size_t size);
+        /// @brief lua_Alloc semantics: frees block if nsize is 0
+        /// @return nullptr if out of memory, original block is kept then
+        void* reallocate(void* ptr, size_t osize, size_t nsize);
+
+        /// @brief Currently allocated by Lua bytes
+        size_t getUsedBytes() const {
+            return usedBytes;
+        }
+
+        size_t getPeakBytes() const {
+            return peakBytes;
+        }
+
+        /// @brief Memory reserved by pool pages
+        size_t getPagesBytes() const {
+            return pages.size() * PAGE_SIZE;
+        }
+
+        /// @brief lua_Alloc function, ud is the Allocator
+        static void* alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+    private:
+        static constexpr size_t CLASSES_COUNT =
+            MAX_POOLED_SIZE / SIZE_CLASS_STEP;
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+        std::array<FreeBlock*, CLASSES_COUNT> freeLists {};
+        std::vector<std::unique_ptr<uint8_t[]>> pages;
+        uint8_t* pageCursor = nullptr;
+        size_t pageLeft = 0;
+
+        size_t usedBytes = 0;
+        size_t peakBytes = 0;
+
+        static size_t get_size_class(size_t size) {
+            return (size + SIZE_CLASS_STEP - 1) / SIZE_CLASS_STEP - 1;
+        }
+        void* allocatePooled(size_t sizeClass);
+    };
+}
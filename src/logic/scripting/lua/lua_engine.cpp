@@ -10,10 +10,22 @@
 #include "libs/api_lua.hpp"
 #include "lua_custom_types.hpp"
 #include "engine/Engine.hpp"
+#include "util/timeutil.hpp"
 
 static debug::Logger logger("lua-state");
 static lua::State* main_thread = nullptr;
 
+/// @brief Collector pause (percents). Higher than default as most of
+/// the work is expected to be done by step_gc in idle time
+inline constexpr int GC_PAUSE = 250;
+/// @brief Collector speed relative to memory allocation (percents)
+inline constexpr int GC_STEPMUL = 200;
+/// @brief Size of a single idle garbage collection step (KiB)
+inline constexpr int GC_STEP_SIZE = 16;
+/// @brief Registry field storing memory usage (KiB) step_gc starts the
+/// next collection cycle at
+inline constexpr const char* GC_THRESHOLD_FIELD = "__vc_gc_threshold";
+
 using namespace lua;
 
 luaerror::luaerror(const std::string& message) : std::runtime_error(message) {
@@ -42,14 +54,9 @@ static void remove_lib_funcs(
 static void create_libs(State* L, StateType stateType) {
     openlib(L, "base64", base64lib);
     openlib(L, "bjson", bjsonlib);
-    openlib(L, "block", blocklib);
     openlib(L, "byteutil", byteutillib);
-    openlib(L, "file", filelib);
-    openlib(L, "generation", generationlib);
-    openlib(L, "item", itemlib);
     openlib(L, "json", jsonlib);
     openlib(L, "mat4", mat4lib);
-    openlib(L, "pack", packlib);
     openlib(L, "quat", quatlib);
     openlib(L, "toml", tomllib);
     openlib(L, "utf8", utf8lib);
@@ -58,6 +65,19 @@ static void create_libs(State* L, StateType stateType) {
     openlib(L, "vec4", vec4lib);
     openlib(L, "yaml", yamllib);
 
+    if (stateType == StateType::WORKER) {
+        // worker states run in pool threads, so world, content and
+        // writeable files access is not allowed. Read-only file functions
+        // are required to load modules
+        openlib(L, "file", filereadlib);
+    } else {
+        openlib(L, "block", blocklib);
+        openlib(L, "file", filelib);
+        openlib(L, "generation", generationlib);
+        openlib(L, "item", itemlib);
+        openlib(L, "pack", packlib);
+    }
+
     if (stateType == StateType::SCRIPT) {
         openlib(L, "app", applib);
     } else if (stateType == StateType::BASE) {
@@ -75,6 +95,7 @@ static void create_libs(State* L, StateType stateType) {
         openlib(L, "player", playerlib);
         openlib(L, "time", timelib);
         openlib(L, "world", worldlib);
+        openlib(L, "workers", workerslib);
 
         openlib(L, "entities", entitylib);
         openlib(L, "cameras", cameralib);
@@ -135,6 +156,10 @@ void lua::initialize(const EnginePaths& paths, const CoreParameters& params) {
 }
 
 void lua::finalize() {
+    if (auto allocator = get_allocator(main_thread)) {
+        logger.info() << "main state memory peak: "
+                      << allocator->getPeakBytes() / 1024 << " KiB";
+    }
     lua::close(main_thread);
 }
 
@@ -157,11 +182,27 @@ State* lua::get_main_state() {
     return main_thread;
 }
 
+static int panic_handler(State* L) {
+    logger.error() << "unprotected error in call to Lua API ("
+                   << (isstring(L, -1) ? tostring(L, -1) : "?") << ")";
+    return 0;
+}
+
 State* lua::create_state(const EnginePaths& paths, StateType stateType) {
-    auto L = luaL_newstate();
+    auto allocator = std::make_unique<Allocator>();
+    auto L = lua_newstate(Allocator::alloc, allocator.get());
+    if (L != nullptr) {
+        allocator.release();
+    } else {
+        // custom allocators are not supported by non-GC64 x64 LuaJIT builds
+        L = luaL_newstate();
+    }
     if (L == nullptr) {
         throw luaerror("could not initialize Lua state");
     }
+    lua_atpanic(L, panic_handler);
+    lua_gc(L, LUA_GCSETPAUSE, GC_PAUSE);
+    lua_gc(L, LUA_GCSETSTEPMUL, GC_STEPMUL);
     init_state(L, stateType);
     
     auto file = "res:scripts/stdmin.lua";
@@ -169,3 +210,38 @@ State* lua::create_state(const EnginePaths& paths, StateType stateType) {
     lua::pop(L, lua::execute(L, 0, src, "core:scripts/stdmin.lua"));
     return L;
 }
+
+void lua::close(State* L) {
+    auto allocator = get_allocator(L);
+    lua_close(L);
+    delete allocator;
+}
+
+Allocator* lua::get_allocator(State* L) {
+    void* ud = nullptr;
+    if (lua_getallocf(L, &ud) != Allocator::alloc) {
+        return nullptr;
+    }
+    return reinterpret_cast<Allocator*>(ud);
+}
+
+bool lua::step_gc(State* L, int64_t maxDuration) {
+    // a step made while the collector is paused starts a new cycle, so the
+    // pause is kept here the same way the collector does it
+    lua_getfield(L, LUA_REGISTRYINDEX, GC_THRESHOLD_FIELD);
+    auto threshold = lua_tointeger(L, -1);
+    lua_pop(L, 1);
+    if (lua_gc(L, LUA_GCCOUNT, 0) < threshold) {
+        return false;
+    }
+    timeutil::Timer timer;
+    do {
+        if (lua_gc(L, LUA_GCSTEP, GC_STEP_SIZE)) {
+            threshold = lua_gc(L, LUA_GCCOUNT, 0) / 100 * GC_PAUSE;
+            lua_pushinteger(L, threshold);
+            lua_setfield(L, LUA_REGISTRYINDEX, GC_THRESHOLD_FIELD);
+            return true;
+        }
+    } while (timer.stop() < maxDuration);
+    return false;
+}
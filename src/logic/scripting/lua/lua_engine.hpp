@@ -6,6 +6,7 @@
 #include "delegates.hpp"
 #include "logic/scripting/scripting_functional.hpp"
 #include "lua_util.hpp"
+#include "lua_allocator.hpp"
 
 class EnginePaths;
 struct CoreParameters;
@@ -15,6 +16,8 @@ namespace lua {
         BASE,
         SCRIPT,
         GENERATOR,
+        /// @brief Isolated state running jobs off the main thread
+        WORKER,
     };
 
     void initialize(const EnginePaths& paths, const CoreParameters& params);
@@ -27,6 +30,16 @@ namespace lua {
     );
     State* get_main_state();
     State* create_state(const EnginePaths& paths, StateType stateType);
+    /// @brief Close state and release its allocator
+    void close(State* L);
+    /// @return state allocator or nullptr if the default one is used
+    Allocator* get_allocator(State* L);
+    /// @brief Perform incremental garbage collection steps until the cycle
+    /// is finished. Does nothing until memory usage reaches the collector
+    /// pause threshold after the previous cycle
+    /// @param maxDuration time budget in microseconds
+    /// @return true if garbage collection cycle has been finished
+    bool step_gc(State* L, int64_t maxDuration);
     [[nodiscard]] scriptenv create_environment(State* L);
 
     void init_state(State* L, StateType stateType);
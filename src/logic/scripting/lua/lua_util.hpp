@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <stdexcept>
 #include <typeindex>
 #include <typeinfo>
@@ -10,6 +11,7 @@
 #include "lua_wrapper.hpp"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
 
 // NOTE: const std::string& used instead of string_view because c_str() needed
 namespace lua {
@@ -48,6 +50,49 @@ namespace lua {
         return true;
     }
 
+    /// @brief LuaJIT cdata type id (not exposed by lua.h)
+    inline constexpr int TCDATA = 10;
+    /// @brief Header tag of FFI vector and matrix types
+    /// (see res/modules/internal/vecmath.lua), lower 16 bits store
+    /// number of components
+    inline constexpr uint32_t VECMATH_TAG = 0x564D0000;
+
+    inline bool iscdata(lua::State* L, int idx) {
+        return lua_type(L, idx) == TCDATA;
+    }
+
+    /// @brief Get number of components of FFI vector or matrix
+    /// @return 0 if value is not a vecmath cdata
+    inline int vecmath_size(lua::State* L, int idx) {
+        if (!iscdata(L, idx)) {
+            return 0;
+        }
+        // lua_topointer returns cdata payload address in LuaJIT
+        auto tag = static_cast<const uint32_t*>(lua_topointer(L, idx));
+        if (tag == nullptr || (*tag & 0xFFFF0000) != VECMATH_TAG) {
+            return 0;
+        }
+        return *tag & 0xFFFF;
+    }
+
+    /// @brief Get FFI vector or matrix components
+    /// @return nullptr if value is not a vecmath cdata of n components
+    inline float* tovecmath(lua::State* L, int idx, int n) {
+        if (vecmath_size(L, idx) != n) {
+            return nullptr;
+        }
+        auto tag = static_cast<const uint32_t*>(lua_topointer(L, idx));
+        return reinterpret_cast<float*>(const_cast<uint32_t*>(tag + 1));
+    }
+
+    /// @brief Get table length or FFI vector/matrix components number
+    inline size_t veclen(lua::State* L, int idx) {
+        if (iscdata(L, idx)) {
+            return vecmath_size(L, idx);
+        }
+        return objlen(L, idx);
+    }
+
     template <int n>
     inline int pushvec(lua::State* L, const glm::vec<n, float>& vec) {
         createtable(L, n, 0);
@@ -151,6 +196,10 @@ namespace lua {
     }
     /// @brief pushes matrix table to the stack and updates it with glm matrix
     inline int setmat4(lua::State* L, int idx, glm::mat4 matrix) {
+        if (float* dst = tovecmath(L, idx, 16)) {
+            std::memcpy(dst, glm::value_ptr(matrix), sizeof(float) * 16);
+            return pushvalue(L, idx);
+        }
         pushvalue(L, idx);
         for (uint y = 0; y < 4; y++) {
             for (uint x = 0; x < 4; x++) {
@@ -163,6 +212,13 @@ namespace lua {
     }
     template <int n>
     inline int setvec(lua::State* L, int idx, glm::vec<n, float> vec) {
+        if (int size = vecmath_size(L, idx)) {
+            float* dst = tovecmath(L, idx, size);
+            for (int i = 0; i < n && i < size; i++) {
+                dst[i] = vec[i];
+            }
+            return pushvalue(L, idx);
+        }
         pushvalue(L, idx);
         for (int i = 0; i < n; i++) {
             pushnumber(L, vec[i]);
@@ -307,6 +363,13 @@ namespace lua {
 
     template <int n>
     inline glm::vec<n, float> tovec(lua::State* L, int idx) {
+        if (const float* src = tovecmath(L, idx, n)) {
+            glm::vec<n, float> vec;
+            for (int i = 0; i < n; i++) {
+                vec[i] = src[i];
+            }
+            return vec;
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < n) {
             throw std::runtime_error(
@@ -324,6 +387,9 @@ namespace lua {
     }
 
     inline glm::vec2 tovec2(lua::State* L, int idx) {
+        if (const float* src = tovecmath(L, idx, 2)) {
+            return glm::vec2(src[0], src[1]);
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < 2) {
             throw std::runtime_error("value must be an array of two numbers");
@@ -338,6 +404,9 @@ namespace lua {
         return glm::vec2(x, y);
     }
     inline glm::vec3 tovec3(lua::State* L, int idx) {
+        if (const float* src = tovecmath(L, idx, 3)) {
+            return glm::vec3(src[0], src[1], src[2]);
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < 3) {
             throw std::runtime_error("value must be an array of three numbers");
@@ -355,6 +424,9 @@ namespace lua {
         return glm::vec3(x, y, z);
     }
     inline glm::vec4 tovec4(lua::State* L, int idx) {
+        if (const float* src = tovecmath(L, idx, 4)) {
+            return glm::vec4(src[0], src[1], src[2], src[3]);
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < 4) {
             throw std::runtime_error("value must be an array of four numbers");
@@ -411,6 +483,9 @@ namespace lua {
         );
     }
     inline glm::mat4 tomat4(lua::State* L, int idx) {
+        if (const float* src = tovecmath(L, idx, 16)) {
+            return glm::make_mat4(src);
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < 16) {
             throw std::runtime_error("value must be an array of 16 numbers");
@@ -607,10 +682,6 @@ namespace lua {
     int create_environment(lua::State*, int parent);
     void remove_environment(lua::State*, int id);
 
-    inline void close(lua::State* L) {
-        lua_close(L);
-    }
-
     inline void addfunc(
         lua::State* L, const std::string& name, lua_CFunction func
     ) {
@@ -234,6 +234,10 @@ void scripting::process_post_runnables() {
     }
 }
 
+void scripting::collect_garbage(int64_t maxDuration) {
+    lua::step_gc(lua::get_main_state(), maxDuration);
+}
+
 template <class T>
 static int push_properties_tables(
     lua::State* L, const ContentUnitIndices<T>& indices
@@ -278,6 +282,8 @@ void scripting::on_content_load(Content* content) {
 }
 
 void scripting::on_content_reset() {
+    // worker states keep modules of unloaded packs
+    reset_workers();
     scripting::content = nullptr;
     scripting::indices = nullptr;
 }
@@ -963,6 +969,7 @@ void scripting::load_layout_script(
 }
 
 void scripting::close() {
+    reset_workers();
     lua::finalize();
     content = nullptr;
     indices = nullptr;
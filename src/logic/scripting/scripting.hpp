@@ -65,6 +65,29 @@ namespace scripting {
 
     void process_post_runnables();
 
+    /// @brief Run Lua function in a worker state. Workers are isolated,
+    /// arguments and result are passed as values copies
+    /// @param module module name in require format ('packid:name')
+    /// @param function module function name
+    /// @param args function argument
+    /// @param callback called in the main thread with the result
+    /// or (nil, error message)
+    void submit_job(
+        const std::string& module,
+        const std::string& function,
+        dv::value args,
+        common_func callback
+    );
+    /// @brief Process completed worker jobs callbacks
+    void update_workers();
+    /// @brief Stop worker states and drop pending callbacks
+    void reset_workers();
+
+    /// @brief Spend idle time on main state incremental garbage collection
+    /// (performs at least one step)
+    /// @param maxDuration time budget in microseconds
+    void collect_garbage(int64_t maxDuration);
+
     std::unique_ptr<Process> start_coroutine(
         const io::path& script
     );
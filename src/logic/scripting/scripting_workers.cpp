@@ -0,0 +1,117 @@
+#include "scripting.hpp"
+
+#include <unordered_map>
+
+#include "lua/lua_engine.hpp"
+#include "data/dv.hpp"
+#include "debug/Logger.hpp"
+#include "engine/Engine.hpp"
+#include "util/ThreadPool.hpp"
+
+using namespace lua;
+
+static debug::Logger logger("scripting-workers");
+
+struct ScriptJob {
+    uint64_t id;
+    /// @brief module name in require format ('packid:name')
+    std::string module;
+    std::string function;
+    dv::value args;
+};
+
+struct ScriptJobResult {
+    uint64_t id;
+    dv::value value;
+    std::string error;
+};
+
+/// @brief Worker owning an isolated Lua state. Modules are loaded with
+/// require, so they stay cached between jobs
+class LuaScriptWorker : public util::Worker<ScriptJob, ScriptJobResult> {
+    State* L;
+public:
+    LuaScriptWorker(const EnginePaths& paths)
+        : L(create_state(paths, StateType::WORKER)) {
+    }
+
+    ~LuaScriptWorker() {
+        close(L);
+    }
+
+    ScriptJobResult operator()(const ScriptJob& job) override {
+        stackguard _(L);
+        try {
+            requireglobal(L, "require");
+            pushstring(L, job.module);
+            call(L, 1, 1);
+            if (!istable(L, -1) || !getfield(L, job.function)) {
+                return ScriptJobResult {
+                    job.id,
+                    nullptr,
+                    "function " + job.module + "." + job.function +
+                        " not found"};
+            }
+            pushvalue(L, job.args);
+            call(L, 1, 1);
+            return ScriptJobResult {job.id, tovalue(L, -1), ""};
+        } catch (const std::exception& err) {
+            return ScriptJobResult {job.id, nullptr, err.what()};
+        }
+    }
+};
+
+using ScriptWorkersPool = util::ThreadPool<ScriptJob, ScriptJobResult>;
+
+static std::unique_ptr<ScriptWorkersPool> workers_pool;
+static std::unordered_map<uint64_t, common_func> job_callbacks;
+static uint64_t next_job_id = 1;
+
+static void on_job_result(ScriptJobResult& result) {
+    const auto& found = job_callbacks.find(result.id);
+    if (found == job_callbacks.end()) {
+        return;
+    }
+    auto callback = std::move(found->second);
+    job_callbacks.erase(found);
+    if (!result.error.empty()) {
+        logger.error() << result.error;
+        callback({nullptr, result.error});
+    } else {
+        callback({std::move(result.value)});
+    }
+}
+
+void scripting::submit_job(
+    const std::string& module,
+    const std::string& function,
+    dv::value args,
+    common_func callback
+) {
+    if (workers_pool == nullptr) {
+        const auto& paths = engine->getPaths();
+        workers_pool = std::make_unique<ScriptWorkersPool>(
+            "lua-workers",
+            [&paths]() { return std::make_shared<LuaScriptWorker>(paths); },
+            on_job_result,
+            ScriptWorkersPool::QUARTER
+        );
+        workers_pool->setStopOnFail(false);
+    }
+    uint64_t id = next_job_id++;
+    if (callback) {
+        job_callbacks[id] = std::move(callback);
+    }
+    workers_pool->enqueueJob(ScriptJob {id, module, function, std::move(args)});
+}
+
+void scripting::update_workers() {
+    if (workers_pool) {
+        workers_pool->update();
+    }
+}
+
+void scripting::reset_workers() {
+    workers_pool.reset();
+    job_callbacks.clear();
+}
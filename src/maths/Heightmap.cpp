@@ -1,87 +1,162 @@
 #include "Heightmap.hpp"
 
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <stdexcept>
+#include <utility>
 #include <glm/glm.hpp>
 
-static inline float sample_at(
-    const float* buffer,
-    uint width,
-    uint x, uint y
-) {
-    return buffer[y*width+x];
+/// @brief Clamp index to the map size. Negative indices (wrapped) are
+/// clamped to the last one
+static inline uint clamp_index(uint x, uint size) {
+    return x >= size ? size - 1 : x;
 }
 
-static inline float sample_at(
-    const float* buffer,
-    uint width, uint height,
-    uint x, uint y
-) {
-    return buffer[(y >= height ? height-1 : y)*width+(x >= width ? width-1 : x)];
+/// @brief Catmull-Rom spline weights used by cubic interpolation
+static inline void cubic_weights(float x, float w[4]) {
+    float x2 = x * x;
+    float x3 = x2 * x;
+    w[0] = 0.5f * (-x + 2.0f * x2 - x3);
+    w[1] = 0.5f * (2.0f - 5.0f * x2 + 3.0f * x3);
+    w[2] = 0.5f * (x + 4.0f * x2 - 3.0f * x3);
+    w[3] = 0.5f * (-x2 + x3);
 }
 
-static inline float interpolate_cubic(float p[4], float x) {
-    return p[1] + 0.5 * x*(p[2] - p[0] + x*(2.0*p[0] - 5.0*p[1] + 4.0*p[2] - 
-           p[3] + x*(3.0*(p[1] - p[2]) + p[3] - p[0])));
+/// @brief Source sampling positions of the destination axis
+struct ResizeAxis {
+    /// @brief Source indices of the destination coordinates
+    std::vector<uint> indices;
+    /// @brief Fractional parts of the source coordinates
+    std::vector<float> fractions;
+
+    ResizeAxis(uint dstsize, uint srcsize)
+        : indices(dstsize), fractions(dstsize) {
+        for (uint i = 0; i < dstsize; i++) {
+            float coord = static_cast<float>(i) / dstsize * srcsize;
+            // std::floor is redundant here because coord is positive
+            indices[i] = static_cast<uint>(coord);
+            fractions[i] = coord - indices[i];
+        }
+    }
+};
+
+static void resize_nearest(
+    const float* src, uint width, float* dst, uint dstwidth, uint dstheight,
+    const ResizeAxis& xaxis, const ResizeAxis& yaxis
+) {
+    const uint* ix = xaxis.indices.data();
+    for (uint y = 0; y < dstheight; y++) {
+        const float* srcrow = src + yaxis.indices[y] * width;
+        float* dstrow = dst + y * dstwidth;
+        for (uint x = 0; x < dstwidth; x++) {
+            dstrow[x] = srcrow[ix[x]];
+        }
+    }
 }
 
-static inline float interpolate_bicubic(float p[4][4], float x, float y) {
-    float q[4];
-    for (int i = 0; i < 4; i++) {
-        q[i] = interpolate_cubic(p[i], y);
+/// @brief Separable bilinear resize: source rows are interpolated
+/// horizontally, then the pair of rows is blended with contiguous
+/// (vectorizable) loops
+static void resize_linear(
+    const float* src, uint width, uint height,
+    float* dst, uint dstwidth, uint dstheight,
+    const ResizeAxis& xaxis, const ResizeAxis& yaxis
+) {
+    std::vector<uint> nextx(dstwidth);
+    for (uint x = 0; x < dstwidth; x++) {
+        nextx[x] = clamp_index(xaxis.indices[x] + 1, width);
+    }
+    const uint* ix0 = xaxis.indices.data();
+    const uint* ix1 = nextx.data();
+    const float* tx = xaxis.fractions.data();
+
+    std::vector<float> rows(dstwidth * 2);
+    float* row0 = rows.data();
+    float* row1 = rows.data() + dstwidth;
+    uint row0y = UINT32_MAX;
+    uint row1y = UINT32_MAX;
+    auto interpolate_row = [=](float* out, uint sy) {
+        const float* srcrow = src + sy * width;
+        for (uint x = 0; x < dstwidth; x++) {
+            float s0 = srcrow[ix0[x]];
+            out[x] = s0 + (srcrow[ix1[x]] - s0) * tx[x];
+        }
+    };
+    for (uint y = 0; y < dstheight; y++) {
+        uint sy0 = yaxis.indices[y];
+        uint sy1 = clamp_index(sy0 + 1, height);
+        if (sy0 != row0y) {
+            if (sy0 == row1y) {
+                std::swap(row0, row1);
+                std::swap(row0y, row1y);
+            } else {
+                interpolate_row(row0, sy0);
+                row0y = sy0;
+            }
+        }
+        if (sy1 != row1y) {
+            interpolate_row(row1, sy1);
+            row1y = sy1;
+        }
+        float ty = yaxis.fractions[y];
+        float* dstrow = dst + y * dstwidth;
+        for (uint x = 0; x < dstwidth; x++) {
+            dstrow[x] = row0[x] + (row1[x] - row0[x]) * ty;
+        }
     }
-    return interpolate_cubic(q, x);
 }
 
-static inline float sample_at(
-    const float* buffer,
-    uint width, uint height,
-    float x, float y,
-    InterpolationType interp
+/// @brief Separable bicubic resize: required source rows are interpolated
+/// horizontally once, then each destination row is a weighted sum of four
+/// contiguous rows
+static void resize_cubic(
+    const float* src, uint width, uint height,
+    float* dst, uint dstwidth, uint dstheight,
+    const ResizeAxis& xaxis, const ResizeAxis& yaxis
 ) {
-    // std::floor is redundant here because x and y are positive values
-    uint ix = static_cast<uint>(x);
-    uint iy = static_cast<uint>(y);
-    float val = buffer[iy*width+ix];
-    if (interp == InterpolationType::NEAREST) {
-        return val;
+    std::vector<uint> xindices(dstwidth * 4);
+    std::vector<float> xweights(dstwidth * 4);
+    for (uint x = 0; x < dstwidth; x++) {
+        for (uint j = 0; j < 4; j++) {
+            xindices[x * 4 + j] =
+                clamp_index(xaxis.indices[x] + j - 1, width);
+        }
+        cubic_weights(xaxis.fractions[x], &xweights[x * 4]);
     }
-    float tx = x - ix;
-    float ty = y - iy;
 
-    switch (interp) {
-        case InterpolationType::LINEAR: {
-            float s00 = val;
-            float s10 = sample_at(buffer, width, 
-                ix + 1 < width ? ix + 1 : ix, iy);
-            float s01 = sample_at(buffer, width, ix, 
-                iy + 1 < height ? iy + 1 : iy);
-            float s11 = sample_at(buffer, width, 
-                ix + 1 < width ? ix + 1 : ix, iy + 1 < height ? iy + 1 : iy);
-
-            float a00 = s00;
-            float a10 = s10 - s00;
-            float a01 = s01 - s00;
-            float a11 = s11 - s10 - s01 + s00;
-
-            return a00 + a10*tx + a01*ty + a11*tx*ty;
+    // horizontally interpolated source rows, computed on demand
+    std::vector<float> rows(static_cast<size_t>(height) * dstwidth);
+    std::vector<bool> ready(height);
+    auto require_row = [&](uint sy) -> const float* {
+        float* out = rows.data() + static_cast<size_t>(sy) * dstwidth;
+        if (ready[sy]) {
+            return out;
         }
-        case InterpolationType::CUBIC: {
-            float p[4][4];
-            for (int i = 0; i < 4; i++) {
-                for (int j = 0; j < 4; j++) {
-                    p[i][j] = sample_at(
-                        buffer, width, height, ix + j - 1, iy + i - 1
-                    );
-                }
-            }
-            return interpolate_bicubic(p, ty, tx);
+        const float* srcrow = src + sy * width;
+        const uint* ix = xindices.data();
+        const float* w = xweights.data();
+        for (uint x = 0; x < dstwidth; x++, ix += 4, w += 4) {
+            out[x] = srcrow[ix[0]] * w[0] + srcrow[ix[1]] * w[1] +
+                     srcrow[ix[2]] * w[2] + srcrow[ix[3]] * w[3];
+        }
+        ready[sy] = true;
+        return out;
+    };
+    for (uint y = 0; y < dstheight; y++) {
+        uint iy = yaxis.indices[y];
+        const float* r0 = require_row(clamp_index(iy - 1, height));
+        const float* r1 = require_row(clamp_index(iy, height));
+        const float* r2 = require_row(clamp_index(iy + 1, height));
+        const float* r3 = require_row(clamp_index(iy + 2, height));
+        float w[4];
+        cubic_weights(yaxis.fractions[y], w);
+        float* dstrow = dst + y * dstwidth;
+        for (uint x = 0; x < dstwidth; x++) {
+            dstrow[x] =
+                r0[x] * w[0] + r1[x] * w[1] + r2[x] * w[2] + r3[x] * w[3];
         }
-        default:
-            throw std::runtime_error("interpolation type is not implemented");
     }
-    return val;
 }
 
 void Heightmap::resize(
@@ -93,13 +168,29 @@ void Heightmap::resize(
     std::vector<float> dst;
     dst.resize(dstwidth*dstheight);
 
-    uint index = 0;
-    for (uint y = 0; y < dstheight; y++) {
-        for (uint x = 0; x < dstwidth; x++, index++) {
-            float sx = static_cast<float>(x) / dstwidth * width;
-            float sy = static_cast<float>(y) / dstheight * height;
-            dst[index] = sample_at(buffer.data(), width, height, sx, sy, interp);
-        }
+    ResizeAxis xaxis(dstwidth, width);
+    ResizeAxis yaxis(dstheight, height);
+    switch (interp) {
+        case InterpolationType::NEAREST:
+            resize_nearest(
+                buffer.data(), width, dst.data(), dstwidth, dstheight,
+                xaxis, yaxis
+            );
+            break;
+        case InterpolationType::LINEAR:
+            resize_linear(
+                buffer.data(), width, height, dst.data(), dstwidth, dstheight,
+                xaxis, yaxis
+            );
+            break;
+        case InterpolationType::CUBIC:
+            resize_cubic(
+                buffer.data(), width, height, dst.data(), dstwidth, dstheight,
+                xaxis, yaxis
+            );
+            break;
+        default:
+            throw std::runtime_error("interpolation type is not implemented");
     }
 
     width = dstwidth;
@@ -118,23 +209,25 @@ void Heightmap::crop(
         return;
     }
 
-    std::vector<float> dst;
-    dst.resize(dstwidth*dstheight);
-
+    // rows are moved in place: destination row never goes after its source
     for (uint y = 0; y < dstheight; y++) {
-        std::memcpy(
-            dst.data()+y*dstwidth, 
+        std::memmove(
+            buffer.data()+y*dstwidth, 
             buffer.data()+(y+srcy)*width+srcx, 
             dstwidth*sizeof(float));
     }
 
     width = dstwidth;
     height = dstheight;
-    buffer = std::move(dst);
+    buffer.resize(dstwidth*dstheight);
 }
 
 void Heightmap::clamp() {
-    for (uint i = 0; i < width * height; i++) {
-        buffer[i] = std::min(1.0f, std::max(0.0f, buffer[i]));
+    float* values = buffer.data();
+    size_t size = buffer.size();
+    for (size_t i = 0; i < size; i++) {
+        float value = values[i];
+        value = 0.0f < value ? value : 0.0f;
+        values[i] = value < 1.0f ? value : 1.0f;
     }
 }
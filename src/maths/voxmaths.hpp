@@ -7,6 +7,11 @@ inline constexpr int floordiv(int a, int b) {
     return a / b;
 }
 
+inline constexpr int floormod(int a, int b) {
+    int m = a % b;
+    return m < 0 ? m + b : m;
+}
+
 inline constexpr bool is_pot(int a) {
     return (a > 0) && ((a & (a - 1)) == 0);
 }
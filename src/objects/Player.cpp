@@ -12,6 +12,7 @@
 #include "rigging.hpp"
 #include "physics/Hitbox.hpp"
 #include "physics/PhysicsSolver.hpp"
+#include "voxels/Chunk.hpp"
 #include "voxels/Chunks.hpp"
 #include "window/Camera.hpp"
 #include "world/Level.hpp"
@@ -194,6 +195,15 @@ void Player::attemptToFindSpawnpoint() {
         rand() % 80 + 100,
         position.z + (rand() % 200 - 100)
     );
+    int ix = std::floor(newpos.x);
+    int iz = std::floor(newpos.z);
+    if (auto chunk = chunks->getChunkByVoxel(ix, 0, iz)) {
+        // no obstacles above the highest non-air block
+        int top = chunk->heights.get(
+            HeightmapType::NON_AIR, ix - chunk->x * CHUNK_W, iz - chunk->z * CHUNK_D
+        );
+        newpos.y = std::min(newpos.y, static_cast<float>(top + 2));
+    }
     while (newpos.y > 0 &&
            !chunks->isObstacleBlock(newpos.x, newpos.y - 2, newpos.z)) {
         newpos.y--;
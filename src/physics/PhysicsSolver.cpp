@@ -4,6 +4,7 @@
 #include "maths/aabb.hpp"
 #include "voxels/Block.hpp"
 #include "voxels/GlobalChunks.hpp"
+#include "voxels/blocks_agent.hpp"
 #include "voxels/voxel.hpp"
 
 #include <iostream>
@@ -14,6 +15,8 @@
 const float E = 0.03f;
 const float MAX_FIX = 0.1f;
 
+using ChunksCursor = blocks_agent::ChunksCursor<const GlobalChunks>;
+
 PhysicsSolver::PhysicsSolver(glm::vec3 gravity) : gravity(gravity) {
 }
 
@@ -35,6 +38,7 @@ void PhysicsSolver::step(
     
     bool prevGrounded = hitbox.grounded;
     hitbox.grounded = false;
+    ChunksCursor cursor(chunks);
     for (uint i = 0; i < substeps; i++) {
         float px = pos.x;
         float py = pos.y;
@@ -63,7 +67,7 @@ void PhysicsSolver::step(
                 float x = (px-half.x+E) + ix * s;
                 for (int iz = 0; iz <= (half.z-E)*2/s; iz++){
                     float z = (pos.z-half.z+E) + iz * s;
-                    if (chunks.isObstacleAt(x,y,z)){
+                    if (blocks_agent::is_obstacle_at(cursor, x,y,z)){
                         hitbox.grounded = true;
                         break;
                     }
@@ -77,7 +81,7 @@ void PhysicsSolver::step(
                 float x = (pos.x-half.x+E) + ix * s;
                 for (int iz = 0; iz <= (half.z-E)*2/s; iz++){
                     float z = (pz-half.z+E) + iz * s;
-                    if (chunks.isObstacleAt(x,y,z)){
+                    if (blocks_agent::is_obstacle_at(cursor, x,y,z)){
                         hitbox.grounded = true;
                         break;
                     }
@@ -119,7 +123,7 @@ void PhysicsSolver::step(
 }
 
 static float calc_step_height(
-    const GlobalChunks& chunks, 
+    const ChunksCursor& chunks,
     const glm::vec3& pos, 
     const glm::vec3& half,
     float stepHeight,
@@ -130,7 +134,9 @@ static float calc_step_height(
             float x = (pos.x-half.x+E) + ix * s;
             for (int iz = 0; iz <= (half.z-E)*2/s; iz++) {
                 float z = (pos.z-half.z+E) + iz * s;
-                if (chunks.isObstacleAt(x, pos.y+half.y+stepHeight, z)) {
+                if (blocks_agent::is_obstacle_at(
+                        chunks, x, pos.y + half.y + stepHeight, z
+                    )) {
                     return 0.0f;
                 }
             }
@@ -141,7 +147,7 @@ static float calc_step_height(
 
 template <int nx, int ny, int nz>
 static bool calc_collision_neg(
-    const GlobalChunks& chunks,
+    const ChunksCursor& chunks,
     glm::vec3& pos,
     glm::vec3& vel,
     const glm::vec3& half,
@@ -159,7 +165,9 @@ static bool calc_collision_neg(
             coord[nz] = (pos[nz]-half[nz]+E) + iz * s;
             coord[nx] = (pos[nx]-half[nx]-E);
 
-            if (const auto aabb = chunks.isObstacleAt(coord.x, coord.y, coord.z)) {
+            if (const auto aabb = blocks_agent::is_obstacle_at(
+                    chunks, coord.x, coord.y, coord.z
+                )) {
                 vel[nx] = 0.0f;
                 float newx = std::floor(coord[nx]) + aabb->max()[nx] + half[nx] + E;
                 if (std::abs(newx-pos[nx]) <= MAX_FIX) {
@@ -174,7 +182,7 @@ static bool calc_collision_neg(
 
 template <int nx, int ny, int nz>
 static void calc_collision_pos(
-    const GlobalChunks& chunks,
+    const ChunksCursor& chunks,
     glm::vec3& pos,
     glm::vec3& vel,
     const glm::vec3& half,
@@ -191,7 +199,9 @@ static void calc_collision_pos(
         for (int iz = 0; iz <= (half[nz]-E)*2/s; iz++) {
             coord[nz] = (pos[nz]-half[nz]+E) + iz * s;
             coord[nx] = (pos[nx]+half[nx]+E);
-            if (const auto aabb = chunks.isObstacleAt(coord.x, coord.y, coord.z)) {
+            if (const auto aabb = blocks_agent::is_obstacle_at(
+                    chunks, coord.x, coord.y, coord.z
+                )) {
                 vel[nx] = 0.0f;
                 float newx = std::floor(coord[nx]) - half[nx] + aabb->min()[nx] - E;
                 if (std::abs(newx-pos[nx]) <= MAX_FIX) {
@@ -213,18 +223,19 @@ void PhysicsSolver::colisionCalc(
 ) {
     // step size (smaller - more accurate, but slower)
     float s = 2.0f/BLOCK_AABB_GRID;
+    ChunksCursor cursor(chunks);
 
-    stepHeight = calc_step_height(chunks, pos, half, stepHeight, s);
+    stepHeight = calc_step_height(cursor, pos, half, stepHeight, s);
 
     const AABB* aabb;
     
-    calc_collision_neg<0, 1, 2>(chunks, pos, vel, half, stepHeight, s);
-    calc_collision_pos<0, 1, 2>(chunks, pos, vel, half, stepHeight, s);
+    calc_collision_neg<0, 1, 2>(cursor, pos, vel, half, stepHeight, s);
+    calc_collision_pos<0, 1, 2>(cursor, pos, vel, half, stepHeight, s);
 
-    calc_collision_neg<2, 1, 0>(chunks, pos, vel, half, stepHeight, s);
-    calc_collision_pos<2, 1, 0>(chunks, pos, vel, half, stepHeight, s);
+    calc_collision_neg<2, 1, 0>(cursor, pos, vel, half, stepHeight, s);
+    calc_collision_pos<2, 1, 0>(cursor, pos, vel, half, stepHeight, s);
 
-    if (calc_collision_neg<1, 0, 2>(chunks, pos, vel, half, stepHeight, s)) {
+    if (calc_collision_neg<1, 0, 2>(cursor, pos, vel, half, stepHeight, s)) {
         hitbox.grounded = true;
     }
 
@@ -234,7 +245,7 @@ void PhysicsSolver::colisionCalc(
             for (int iz = 0; iz <= (half.z-E)*2/s; iz++) {
                 float z = (pos.z-half.z+E) + iz * s;
                 float y = (pos.y-half.y+E);
-                if ((aabb = chunks.isObstacleAt(x,y,z))){
+                if ((aabb = blocks_agent::is_obstacle_at(cursor, x,y,z))){
                     vel.y = 0.0f;
                     float newy = std::floor(y) + aabb->max().y + half.y;
                     if (std::abs(newy-pos.y) <= MAX_FIX+stepHeight) {
@@ -251,7 +262,7 @@ void PhysicsSolver::colisionCalc(
             for (int iz = 0; iz <= (half.z-E)*2/s; iz++) {
                 float z = (pos.z-half.z+E) + iz * s;
                 float y = (pos.y+half.y+E);
-                if ((aabb = chunks.isObstacleAt(x,y,z))){
+                if ((aabb = blocks_agent::is_obstacle_at(cursor, x,y,z))){
                     vel.y = 0.0f;
                     float newy = std::floor(y) - half.y + aabb->min().y - E;
                     if (std::abs(newy-pos.y) <= MAX_FIX) {
@@ -42,6 +42,21 @@ struct ChunksSettings {
     IntegerSetting padding {2, 1, 8};
 };
 
+/// @brief Level update phases time budgets (milliseconds). Deferrable work
+/// is continued on the next tick, overruns are reported to log
+struct TickSettings {
+    /// @brief Blocks ticks and random ticks
+    IntegerSetting blocksBudget {10, 1, 50};
+    /// @brief Entities physics
+    IntegerSetting physicsBudget {10, 1, 50};
+    /// @brief Entities update
+    IntegerSetting entitiesBudget {10, 1, 50};
+    /// @brief Players tick
+    IntegerSetting playersBudget {5, 1, 50};
+    /// @brief Max scheduled blocks updates processed per blocks tick
+    IntegerSetting blockUpdatesLimit {4096, 64, 65536};
+};
+
 struct CameraSettings {
     /// @brief Camera dynamic field of view effects
     FlagSetting fovEffects {true};
@@ -90,6 +105,9 @@ struct DebugSettings {
     FlagSetting generatorTestMode {false};
     /// @brief Write lights cache
     FlagSetting doWriteLights {true};
+    /// @brief Write block inventories in compact binary format. Worlds
+    /// written with it are not readable by engines before 0.28
+    FlagSetting compactInventories {false};
 };
 
 struct UiSettings {
@@ -104,6 +122,7 @@ struct EngineSettings {
     AudioSettings audio;
     DisplaySettings display;
     ChunksSettings chunks;
+    TickSettings tick;
     CameraSettings camera;
     GraphicsSettings graphics;
     DebugSettings debug;
@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "content/Content.hpp"
 #include "content/ContentReport.hpp"
 #include "items/Inventory.hpp"
 #include "lighting/Lightmap.hpp"
@@ -28,6 +29,19 @@ void Chunk::updateHeights() {
     }
 }
 
+void Chunk::updateRandomUpdateVoxels(const ContentIndices& indices) {
+    const auto& blocks = indices.blocks;
+    constexpr int segmentVolume = RANDOM_UPDATE_SEGMENT_H * CHUNK_D * CHUNK_W;
+    for (int s = 0; s < RANDOM_UPDATE_SEGMENTS; s++) {
+        uint count = 0;
+        const voxel* segment = voxels + s * segmentVolume;
+        for (int i = 0; i < segmentVolume; i++) {
+            count += blocks.require(segment[i].id).rt.funcsset.randupdate;
+        }
+        randomUpdateVoxels[s] = count;
+    }
+}
+
 void Chunk::addBlockInventory(
     std::shared_ptr<Inventory> inventory, uint x, uint y, uint z
 ) {
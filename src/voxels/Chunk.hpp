@@ -2,6 +2,7 @@
 
 #include <stdlib.h>
 
+#include <array>
 #include <memory>
 #include <unordered_map>
 
@@ -10,11 +11,13 @@
 #include "util/SmallHeap.hpp"
 #include "maths/aabb.hpp"
 #include "voxel.hpp"
+#include "ChunkHeights.hpp"
 
 /// @brief Total bytes number of chunk voxel data
 inline constexpr int CHUNK_DATA_LEN = CHUNK_VOL * 4;
 
 class ContentReport;
+class ContentIndices;
 class Inventory;
 
 using ChunkInventoriesMap =
@@ -24,10 +27,17 @@ using BlocksMetadata = util::SmallHeap<uint16_t, uint8_t>;
 
 class Chunk {
 public:
+    /// @brief Number of horizontal segments used by random ticks
+    static inline constexpr int RANDOM_UPDATE_SEGMENTS = 4;
+    static inline constexpr int RANDOM_UPDATE_SEGMENT_H =
+        CHUNK_H / RANDOM_UPDATE_SEGMENTS;
+
     int x, z;
     int bottom, top;
     voxel voxels[CHUNK_VOL] {};
     Lightmap lightmap;
+    /// @brief Per-column heightmaps (see ChunkHeights)
+    ChunkHeights heights;
     struct {
         bool modified : 1;
         bool ready : 1;
@@ -38,6 +48,13 @@ public:
         bool entities : 1;
         bool blocksData : 1;
     } flags {};
+    /// @brief Bit mask of chunks present in 3x3 area around this chunk
+    /// (bit index is (dz + 1) * 3 + (dx + 1)), maintained by GlobalChunks
+    uint16_t neighbors = 0;
+    /// @brief Number of voxels of blocks having on_random_update handler
+    /// per random ticks segment. Segments with zero are skipped by random
+    /// ticks
+    std::array<uint16_t, RANDOM_UPDATE_SEGMENTS> randomUpdateVoxels {};
 
     /// @brief Block inventories map where key is index of block in voxels array
     ChunkInventoriesMap inventories;
@@ -49,6 +66,9 @@ public:
     /// @brief Refresh `bottom` and `top` values
     void updateHeights();
 
+    /// @brief Recount randomUpdateVoxels from scratch
+    void updateRandomUpdateVoxels(const ContentIndices& indices);
+
     // unused
     std::unique_ptr<Chunk> clone() const;
 
@@ -63,6 +83,14 @@ public:
     /// @return inventory bound to the given block or nullptr
     std::shared_ptr<Inventory> getBlockInventory(uint x, uint y, uint z) const;
 
+    /// @brief Mask value meaning all of 3x3 area chunks are present
+    static inline constexpr uint16_t NEIGHBORS_ALL = 0x1FF;
+
+    /// @return true if all 8 neighbour chunks are present
+    bool isSurrounded() const {
+        return neighbors == NEIGHBORS_ALL;
+    }
+
     inline void setModifiedAndUnsaved() {
         flags.modified = true;
         flags.unsaved = true;
@@ -0,0 +1,75 @@
+#include "ChunkHeights.hpp"
+
+#include "content/Content.hpp"
+#include "constants.hpp"
+
+static inline bool is_matching(
+    HeightmapType type, const BlockPropertiesTable& properties, blockid_t id
+) {
+    switch (type) {
+        case HeightmapType::SOLID:
+            return properties.isSolid(id);
+        case HeightmapType::LIGHT_BLOCKING:
+            return !properties.isSkyLightPassing(id);
+        case HeightmapType::NON_AIR:
+            return id != BLOCK_AIR;
+    }
+    return false;
+}
+
+void ChunkHeights::build(const voxel* voxels, const ContentIndices& indices) {
+    const auto& properties = indices.blockProperties;
+    for (int i = 0; i < TYPES_COUNT; i++) {
+        maps[i].fill(0);
+    }
+    for (int z = 0; z < CHUNK_D; z++) {
+        for (int x = 0; x < CHUNK_W; x++) {
+            int column = z * CHUNK_W + x;
+            int found = 0;
+            for (int y = CHUNK_H - 1; y >= 0 && found < TYPES_COUNT; y--) {
+                blockid_t id = voxels[vox_index(x, y, z)].id;
+                for (int i = 0; i < TYPES_COUNT; i++) {
+                    auto& height = maps[i][column];
+                    if (height == 0 &&
+                        is_matching(
+                            static_cast<HeightmapType>(i), properties, id
+                        )) {
+                        height = y + 1;
+                        found++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ChunkHeights::update(
+    const voxel* voxels, const ContentIndices& indices, int x, int y, int z
+) {
+    const auto& properties = indices.blockProperties;
+    blockid_t id = voxels[vox_index(x, y, z)].id;
+    int column = z * CHUNK_W + x;
+    for (int i = 0; i < TYPES_COUNT; i++) {
+        auto type = static_cast<HeightmapType>(i);
+        auto& height = maps[i][column];
+        if (is_matching(type, properties, id)) {
+            if (y + 1 > height) {
+                height = y + 1;
+            }
+            continue;
+        }
+        if (y + 1 != height) {
+            continue;
+        }
+        // the highest block has been replaced, seeking for the next one
+        height = 0;
+        for (int ly = y - 1; ly >= 0; ly--) {
+            if (is_matching(
+                    type, properties, voxels[vox_index(x, ly, z)].id
+                )) {
+                height = ly + 1;
+                break;
+            }
+        }
+    }
+}
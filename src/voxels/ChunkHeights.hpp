@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+
+#include "constants.hpp"
+#include "typedefs.hpp"
+#include "voxel.hpp"
+#include "util/EnumMetadata.hpp"
+
+class ContentIndices;
+
+enum class HeightmapType {
+    /// @brief highest block having rt.solid
+    SOLID = 0,
+    /// @brief highest block not passing sky light
+    LIGHT_BLOCKING,
+    /// @brief highest non-air block
+    NON_AIR,
+};
+
+VC_ENUM_METADATA(HeightmapType)
+    {"solid", HeightmapType::SOLID},
+    {"light-blocking", HeightmapType::LIGHT_BLOCKING},
+    {"non-air", HeightmapType::NON_AIR},
+VC_ENUM_END
+
+/// @brief Per-column heightmaps of a chunk updated incrementally on
+/// block set
+class ChunkHeights {
+    static inline constexpr int TYPES_COUNT = 3;
+    static inline constexpr int AREA = CHUNK_W * CHUNK_D;
+
+    /// @brief highest matching block Y + 1, 0 if there is no such block
+    std::array<uint16_t, AREA> maps[TYPES_COUNT] {};
+public:
+    /// @brief Build all heightmaps from scratch
+    void build(const voxel* voxels, const ContentIndices& indices);
+
+    /// @brief Update heightmaps after block set
+    /// @param voxels chunk voxels with the block already set
+    /// @param x local block position X
+    /// @param y block position Y
+    /// @param z local block position Z
+    void update(
+        const voxel* voxels, const ContentIndices& indices, int x, int y, int z
+    );
+
+    /// @param x local column position X
+    /// @param z local column position Z
+    /// @return Y of the highest block of the type or -1 if there is no one
+    int get(HeightmapType type, int x, int z) const {
+        return static_cast<int>(
+                   maps[static_cast<int>(type)][z * CHUNK_W + x]
+               ) - 1;
+    }
+};
@@ -66,21 +66,22 @@ const AABB* Chunks::isObstacleAt(float x, float y, float z) const {
             return &empty;
         }
     }
+    if (!indices.blockProperties.isObstacle(v->id)) {
+        return nullptr;
+    }
     const auto& def = indices.blocks.require(v->id);
-    if (def.obstacle) {
-        glm::ivec3 offset {};
-        if (v->state.segment) {
-            glm::ivec3 point(ix, iy, iz);
-            offset = seekOrigin(point, def, v->state) - point;
-        }
-        const auto& boxes =
-            def.rotatable ? def.rt.hitboxes[v->state.rotation] : def.hitboxes;
-        for (const auto& hitbox : boxes) {
-            if (hitbox.contains(
-                {x - ix - offset.x, y - iy - offset.y, z - iz - offset.z}
-            )) {
-                return &hitbox;
-            }
+    glm::ivec3 offset {};
+    if (v->state.segment) {
+        glm::ivec3 point(ix, iy, iz);
+        offset = seekOrigin(point, def, v->state) - point;
+    }
+    const auto& boxes =
+        def.rotatable ? def.rt.hitboxes[v->state.rotation] : def.hitboxes;
+    for (const auto& hitbox : boxes) {
+        if (hitbox.contains(
+            {x - ix - offset.x, y - iy - offset.y, z - iz - offset.z}
+        )) {
+            return &hitbox;
         }
     }
     return nullptr;
@@ -97,7 +98,7 @@ bool Chunks::isReplaceableBlock(int32_t x, int32_t y, int32_t z) {
 bool Chunks::isObstacleBlock(int32_t x, int32_t y, int32_t z) {
     voxel* v = get(x, y, z);
     if (v == nullptr) return false;
-    return indices.blocks.require(v->id).obstacle;
+    return indices.blockProperties.isObstacle(v->id);
 }
 
 ubyte Chunks::getLight(int32_t x, int32_t y, int32_t z, int channel) const {
@@ -333,6 +334,7 @@ bool Chunks::putChunk(const std::shared_ptr<Chunk>& chunk) {
 // 25.06.2024: not now
 // 11.11.2024: not now
 void Chunks::getVoxels(VoxelsVolume& volume, bool backlight) const {
+    const auto& properties = indices.blockProperties;
     voxel* voxels = volume.getVoxels();
     light_t* lights = volume.getLights();
     int x = volume.getX();
@@ -392,9 +394,9 @@ void Chunks::getVoxels(VoxelsVolume& volume, bool backlight) const {
                             voxels[vidx] = cvoxels[cidx];
                             light_t light = clights[cidx];
                             if (backlight) {
-                                const auto block =
-                                    indices.blocks.get(voxels[vidx].id);
-                                if (block && block->lightPassing) {
+                                if (properties.isLightPassing(
+                                        voxels[vidx].id
+                                    )) {
                                     light = Lightmap::combine(
                                         std::min(15,
                                             Lightmap::extract(light, 0) + 1),
@@ -1,5 +1,6 @@
 #include "GlobalChunks.hpp"
 
+#include <vector>
 #include <algorithm>
 
 #include "content/Content.hpp"
@@ -29,6 +30,49 @@ void GlobalChunks::setOnUnload(consumer<Chunk&> onUnload) {
     this->onUnload = std::move(onUnload);
 }
 
+void GlobalChunks::setOnSurrounded(consumer<Chunk&> onSurrounded) {
+    this->onSurrounded = std::move(onSurrounded);
+}
+
+void GlobalChunks::updateNeighbors(Chunk& chunk, bool present) {
+    std::vector<Chunk*> surrounded;
+    if (present) {
+        chunk.neighbors = 0;
+    }
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            Chunk* other = (dx || dz) ? getChunk(chunk.x + dx, chunk.z + dz)
+                                      : &chunk;
+            if (other == nullptr) {
+                continue;
+            }
+            // bit of the chunk in the neighbour mask
+            uint16_t bit = 1 << ((1 - dz) * 3 + (1 - dx));
+            if (!present) {
+                other->neighbors &= ~bit;
+                continue;
+            }
+            chunk.neighbors |= 1 << ((dz + 1) * 3 + (dx + 1));
+            if (other == &chunk) {
+                continue;
+            }
+            bool wasSurrounded = other->isSurrounded();
+            other->neighbors |= bit;
+            if (!wasSurrounded && other->isSurrounded()) {
+                surrounded.push_back(other);
+            }
+        }
+    }
+    if (present && chunk.isSurrounded()) {
+        surrounded.push_back(&chunk);
+    }
+    if (onSurrounded) {
+        for (auto other : surrounded) {
+            onSurrounded(*other);
+        }
+    }
+}
+
 std::shared_ptr<Chunk> GlobalChunks::fetch(int x, int z) {
     const auto& found = chunksMap.find(keyfrom(x, z));
     if (found == chunksMap.end()) {
@@ -62,7 +106,12 @@ static void check_voxels(const ContentIndices& indices, Chunk& chunk) {
 }
 
 void GlobalChunks::erase(int x, int z) {
-    chunksMap.erase(keyfrom(x, z));
+    const auto& found = chunksMap.find(keyfrom(x, z));
+    if (found == chunksMap.end()) {
+        return;
+    }
+    updateNeighbors(*found->second, false);
+    chunksMap.erase(found);
 }
 
 static inline auto load_inventories(
@@ -96,6 +145,7 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z) {
 
     auto chunk = std::make_shared<Chunk>(x, z);
     chunksMap[keyfrom(x, z)] = chunk;
+    updateNeighbors(*chunk, true);
 
     World& world = *level.getWorld();
     auto& regions = world.wfile.get()->getRegions();
@@ -143,6 +193,12 @@ size_t GlobalChunks::size() const {
     return chunksMap.size();
 }
 
+void GlobalChunks::forEach(const consumer<Chunk&>& func) const {
+    for (const auto& [_, chunk] : chunksMap) {
+        func(*chunk);
+    }
+}
+
 void GlobalChunks::incref(Chunk* chunk) {
     auto key = reinterpret_cast<ptrdiff_t>(chunk);
     const auto& found = refCounters.find(key);
@@ -171,6 +227,7 @@ void GlobalChunks::decref(Chunk* chunk) {
         if (onUnload) {
             onUnload(*chunk);
         }
+        updateNeighbors(*chunk, false);
         chunksMap.erase(ekey.key);
         refCounters.erase(found);
     }
@@ -201,7 +258,12 @@ void GlobalChunks::saveAll() {
 }
 
 void GlobalChunks::putChunk(std::shared_ptr<Chunk> chunk) {
-    chunksMap[keyfrom(chunk->x, chunk->z)] = std::move(chunk);
+    auto& entry = chunksMap[keyfrom(chunk->x, chunk->z)];
+    if (entry) {
+        updateNeighbors(*entry, false);
+    }
+    entry = std::move(chunk);
+    updateNeighbors(*entry, true);
 }
 
 const AABB* GlobalChunks::isObstacleAt(float x, float y, float z) const {
@@ -33,12 +33,21 @@ class GlobalChunks {
     std::unordered_map<ptrdiff_t, int> refCounters;
 
     consumer<Chunk&> onUnload;
+    consumer<Chunk&> onSurrounded;
+
+    /// @brief Update neighbour masks of the chunk and chunks around it
+    /// @param present is the chunk added to or removed from the map
+    void updateNeighbors(Chunk& chunk, bool present);
 public:
     GlobalChunks(Level& level);
     ~GlobalChunks() = default;
 
     void setOnUnload(consumer<Chunk&> onUnload);
 
+    /// @brief Set callback called once when all chunk neighbours
+    /// become present
+    void setOnSurrounded(consumer<Chunk&> onSurrounded);
+
     std::shared_ptr<Chunk> fetch(int x, int z);
     std::shared_ptr<Chunk> create(int x, int z);
 
@@ -47,6 +56,9 @@ public:
 
     size_t size() const;
 
+    /// @brief Call func for each loaded chunk
+    void forEach(const consumer<Chunk&>& func) const;
+
     void incref(Chunk* chunk);
     void decref(Chunk* chunk);
 
@@ -13,7 +13,8 @@ static inline void set_block(
     int32_t y,
     int32_t z,
     uint32_t id,
-    blockstate state
+    blockstate state,
+    EditBatch* batch
 ) {
     if (y < 0 || y >= CHUNK_H) {
         return;
@@ -48,12 +49,32 @@ static inline void set_block(
 
     // block initialization
     const auto& newdef = indices.blocks.require(id);
+    if (prevdef.rt.funcsset.randupdate != newdef.rt.funcsset.randupdate) {
+        auto& count =
+            chunk->randomUpdateVoxels[y / Chunk::RANDOM_UPDATE_SEGMENT_H];
+        if (newdef.rt.funcsset.randupdate) {
+            count++;
+        } else {
+            count--;
+        }
+    }
     vox.id = id;
     vox.state = state;
     chunk->setModifiedAndUnsaved();
     if (!state.segment && newdef.rt.extended) {
         repair_segments(chunks, newdef, state, x, y, z);
     }
+    chunk->heights.update(chunk->voxels, indices, lx, y, lz);
+
+    if (batch) {
+        batch->positions.emplace_back(x, y, z);
+        auto& borders = batch->chunks[{cx, cz}];
+        if (lx == 0) borders |= EditBatch::BORDER_NX;
+        if (lz == 0) borders |= EditBatch::BORDER_NZ;
+        if (lx == CHUNK_W - 1) borders |= EditBatch::BORDER_PX;
+        if (lz == CHUNK_D - 1) borders |= EditBatch::BORDER_PZ;
+        return;
+    }
 
     if (y < chunk->bottom)
         chunk->bottom = y;
@@ -84,7 +105,7 @@ void blocks_agent::set(
     uint32_t id,
     blockstate state
 ) {
-    set_block(chunks, x, y, z, id, state);
+    set_block(chunks, x, y, z, id, state, nullptr);
 }
 
 void blocks_agent::set(
@@ -95,7 +116,31 @@ void blocks_agent::set(
     uint32_t id,
     blockstate state
 ) {
-    set_block(chunks, x, y, z, id, state);
+    set_block(chunks, x, y, z, id, state, nullptr);
+}
+
+void blocks_agent::set(
+    Chunks& chunks,
+    int32_t x,
+    int32_t y,
+    int32_t z,
+    uint32_t id,
+    blockstate state,
+    EditBatch& batch
+) {
+    set_block(chunks, x, y, z, id, state, &batch);
+}
+
+void blocks_agent::set(
+    GlobalChunks& chunks,
+    int32_t x,
+    int32_t y,
+    int32_t z,
+    uint32_t id,
+    blockstate state,
+    EditBatch& batch
+) {
+    set_block(chunks, x, y, z, id, state, &batch);
 }
 
 template <class Storage>
@@ -273,7 +318,7 @@ template <class Storage>
 inline void get_voxels_impl(
     const Storage& chunks, VoxelsVolume* volume, bool backlight
 ) {
-    const auto& blocks = chunks.getContentIndices().blocks;
+    const auto& properties = chunks.getContentIndices().blockProperties;
     voxel* voxels = volume->getVoxels();
     light_t* lights = volume->getLights();
     int x = volume->getX();
@@ -333,8 +378,9 @@ inline void get_voxels_impl(
                             voxels[vidx] = cvoxels[cidx];
                             light_t light = clights[cidx];
                             if (backlight) {
-                                const auto block = blocks.get(voxels[vidx].id);
-                                if (block && block->lightPassing) {
+                                if (properties.isLightPassing(
+                                        voxels[vidx].id
+                                    )) {
                                     light = Lightmap::combine(
                                         std::min(15,
                                             Lightmap::extract(light, 0) + 1),
@@ -18,12 +18,42 @@
 #include <algorithm>
 #include <stdint.h>
 #include <stdexcept>
+#include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
 
 struct AABB;
 
 namespace blocks_agent {
 
+/// @brief Deferred side effects of batched blocks set.
+/// Chunk heights bounds and neighbour chunks modified flags are applied
+/// once per touched chunk by apply, lighting and blocks updates are left
+/// to the batch owner (see BlocksController::commitEdit)
+struct EditBatch {
+    /// @brief Touched chunk border bits
+    enum : uint8_t { BORDER_NX = 1, BORDER_NZ = 2, BORDER_PX = 4, BORDER_PZ = 8 };
+
+    /// @brief Positions of set blocks in order of setting
+    std::vector<glm::ivec3> positions;
+    /// @brief Positions which neighbours should be notified on commit
+    std::vector<glm::ivec3> notified;
+    /// @brief Touched chunks with touched borders bits
+    std::unordered_map<glm::ivec2, uint8_t> chunks;
+
+    bool empty() const {
+        return positions.empty();
+    }
+
+    void clear() {
+        positions.clear();
+        notified.clear();
+        chunks.clear();
+    }
+};
+
 /// @brief Get specified chunk.
 /// @tparam Storage 
 /// @param chunks 
@@ -35,6 +65,47 @@ inline Chunk* get_chunk(const Storage& chunks, int cx, int cz) {
     return chunks.getChunk(cx, cz);
 }
 
+/// @brief Chunks storage wrapper caching the last resolved chunk, so
+/// sequential accesses within one chunk resolve it once. May be used as
+/// Storage in the blocks_agent templates. Blocks set calls are forwarded to
+/// the wrapped storage.
+/// Must not outlive the operation it is created for: chunks may be unloaded
+/// between operations.
+/// @tparam Storage chunks storage class
+template<class Storage>
+class ChunksCursor {
+    Storage& chunks;
+    mutable Chunk* chunk = nullptr;
+    mutable int chunkX = 0;
+    mutable int chunkZ = 0;
+    mutable bool resolved = false;
+public:
+    ChunksCursor(Storage& chunks) : chunks(chunks) {
+    }
+
+    /// @brief Get specified chunk, resolved only if differs from the last
+    /// @param cx chunk grid position X
+    /// @param cz chunk grid position Z
+    /// @return chunk or nullptr if does not exists
+    Chunk* getChunk(int cx, int cz) const {
+        if (!resolved || cx != chunkX || cz != chunkZ) {
+            chunk = chunks.getChunk(cx, cz);
+            chunkX = cx;
+            chunkZ = cz;
+            resolved = true;
+        }
+        return chunk;
+    }
+
+    const ContentIndices& getContentIndices() const {
+        return chunks.getContentIndices();
+    }
+
+    Storage& getStorage() const {
+        return chunks;
+    }
+};
+
 /// @brief Get voxel at specified position.
 /// Returns nullptr if voxel does not exists. 
 /// @tparam Storage chunks storage class
@@ -92,7 +163,7 @@ inline const Block& get_block_def(const Storage& chunks, blockid_t id) {
 template<class Storage>
 inline bool is_solid_at(const Storage& chunks, int32_t x, int32_t y, int32_t z) {
     if (auto vox = get(chunks, x, y, z)) {
-        return get_block_def(chunks, vox->id).rt.solid;
+        return chunks.getContentIndices().blockProperties.isSolid(vox->id);
     }
     return false;
 }
@@ -144,6 +215,94 @@ void set(
     blockstate state
 );
 
+/// @brief Set block at specified position if voxel exists, deferring
+/// chunks side effects to the batch
+/// @param chunks chunks matrix
+/// @param x block position X
+/// @param y block position Y
+/// @param z block position Z
+/// @param id new block id
+/// @param state new block state
+/// @param batch edit batch
+void set(
+    Chunks& chunks,
+    int32_t x,
+    int32_t y,
+    int32_t z,
+    uint32_t id,
+    blockstate state,
+    EditBatch& batch
+);
+
+/// @brief Set block at specified position if voxel exists, deferring
+/// chunks side effects to the batch
+/// @param chunks chunks storage
+/// @param x block position X
+/// @param y block position Y
+/// @param z block position Z
+/// @param id new block id
+/// @param state new block state
+/// @param batch edit batch
+void set(
+    GlobalChunks& chunks,
+    int32_t x,
+    int32_t y,
+    int32_t z,
+    uint32_t id,
+    blockstate state,
+    EditBatch& batch
+);
+
+/// @brief Set block at specified position if voxel exists.
+/// @param cursor chunks cursor
+/// @param x block position X
+/// @param y block position Y
+/// @param z block position Z
+/// @param id new block id
+/// @param state new block state
+template <class Storage>
+inline void set(
+    const ChunksCursor<Storage>& cursor,
+    int32_t x,
+    int32_t y,
+    int32_t z,
+    uint32_t id,
+    blockstate state
+) {
+    set(cursor.getStorage(), x, y, z, id, state);
+}
+
+/// @brief Apply deferred chunks side effects of the batch: heights bounds
+/// and neighbour chunks modified flags. Positions are kept
+/// @param chunks chunks storage
+/// @param batch edit batch
+template <class Storage>
+inline void apply(Storage& chunks, EditBatch& batch) {
+    for (const auto& [pos, borders] : batch.chunks) {
+        if (auto chunk = get_chunk(chunks, pos.x, pos.y)) {
+            chunk->updateHeights();
+        }
+        Chunk* chunk;
+        if ((borders & EditBatch::BORDER_NX) &&
+            (chunk = get_chunk(chunks, pos.x - 1, pos.y))) {
+            chunk->flags.modified = true;
+        }
+        if ((borders & EditBatch::BORDER_NZ) &&
+            (chunk = get_chunk(chunks, pos.x, pos.y - 1))) {
+            chunk->flags.modified = true;
+        }
+        if ((borders & EditBatch::BORDER_PX) &&
+            (chunk = get_chunk(chunks, pos.x + 1, pos.y))) {
+            chunk->flags.modified = true;
+        }
+        if ((borders & EditBatch::BORDER_PZ) &&
+            (chunk = get_chunk(chunks, pos.x, pos.y + 1))) {
+            chunk->flags.modified = true;
+        }
+    }
+    batch.chunks.clear();
+}
+
 /// @brief Erase extended block segments
 /// @tparam Storage chunks storage class
 /// @param chunks chunks storage
@@ -231,6 +390,7 @@ inline glm::ivec3 seek_origin(
     auto pos = srcpos;
     const auto& rotation = def.rotations.variants[state.rotation];
     auto segment = state.segment;
+    ChunksCursor cursor(chunks);
     while (true) {
         if (!segment) {
             return pos;
@@ -239,7 +399,7 @@ inline glm::ivec3 seek_origin(
         if (segment & 2) pos -= rotation.axes[1];
         if (segment & 4) pos -= rotation.axes[2];
 
-        if (auto* voxel = get(chunks, pos.x, pos.y, pos.z)) {
+        if (auto* voxel = get(cursor, pos.x, pos.y, pos.z)) {
             segment = voxel->state.segment;
         } else {
             return pos;
@@ -266,6 +426,7 @@ inline bool check_replaceability(
     const auto& blocks = chunks.getContentIndices().blocks;
     const auto& rotation = def.rotations.variants[state.rotation];
     const auto size = def.size;
+    ChunksCursor cursor(chunks);
     for (int sy = 0; sy < size.y; sy++) {
         for (int sz = 0; sz < size.z; sz++) {
             for (int sx = 0; sx < size.x; sx++) {
@@ -273,7 +434,7 @@ inline bool check_replaceability(
                 pos += rotation.axes[0] * sx;
                 pos += rotation.axes[1] * sy;
                 pos += rotation.axes[2] * sz;
-                if (auto vox = get(chunks, pos.x, pos.y, pos.z)) {
+                if (auto vox = get(cursor, pos.x, pos.y, pos.z)) {
                     auto& target = blocks.require(vox->id);
                     if (!target.replaceable && vox->id != ignore) {
                         return false;
@@ -313,6 +474,7 @@ inline void set_rotation_extended(
     const auto& rotation = def.rotations.variants[index];
     const auto size = def.size;
     std::vector<glm::ivec3> segmentBlocks;
+    ChunksCursor cursor(chunks);
 
     for (int sy = 0; sy < size.y; sy++) {
         for (int sz = 0; sz < size.z; sz++) {
@@ -325,7 +487,7 @@ inline void set_rotation_extended(
                 blockstate segState = newstate;
                 segState.segment = segment_to_int(sx, sy, sz);
 
-                auto vox = get(chunks, pos.x, pos.y, pos.z);
+                auto vox = get(cursor, pos.x, pos.y, pos.z);
                 // checked for nullptr by checkReplaceability
                 if (vox->id != def.rt.id) {
                     set(chunks, pos.x, pos.y, pos.z, def.rt.id, segState);
@@ -333,7 +495,7 @@ inline void set_rotation_extended(
                     vox->state = segState;
                     int cx = floordiv<CHUNK_W>(pos.x);
                     int cz = floordiv<CHUNK_D>(pos.z);
-                    auto chunk = get_chunk(chunks, cx, cz);
+                    auto chunk = get_chunk(cursor, cx, cz);
                     assert(chunk != nullptr);
                     chunk->setModifiedAndUnsaved();
                     segmentBlocks.emplace_back(pos);
@@ -455,21 +617,23 @@ inline const AABB* is_obstacle_at(const Storage& chunks, float x, float y, float
             return &empty;
         }
     }
-    const auto& def = chunks.getContentIndices().blocks.require(v->id);
-    if (def.obstacle) {
-        glm::ivec3 offset {};
-        if (v->state.segment) {
-            glm::ivec3 point(ix, iy, iz);
-            offset = seek_origin(chunks, point, def, v->state) - point;
-        }
-        const auto& boxes =
-            def.rotatable ? def.rt.hitboxes[v->state.rotation] : def.hitboxes;
-        for (const auto& hitbox : boxes) {
-            if (hitbox.contains(
-                {x - ix - offset.x, y - iy - offset.y, z - iz - offset.z}
-            )) {
-                return &hitbox;
-            }
+    const auto& indices = chunks.getContentIndices();
+    if (!indices.blockProperties.isObstacle(v->id)) {
+        return nullptr;
+    }
+    const auto& def = indices.blocks.require(v->id);
+    glm::ivec3 offset {};
+    if (v->state.segment) {
+        glm::ivec3 point(ix, iy, iz);
+        offset = seek_origin(chunks, point, def, v->state) - point;
+    }
+    const auto& boxes =
+        def.rotatable ? def.rt.hitboxes[v->state.rotation] : def.hitboxes;
+    for (const auto& hitbox : boxes) {
+        if (hitbox.contains(
+            {x - ix - offset.x, y - iy - offset.y, z - iz - offset.z}
+        )) {
+            return &hitbox;
         }
     }
     return nullptr;
@@ -75,6 +75,8 @@ void compressed_chunks::decode(
         }
         chunk.decode(voxelData.data());
         chunk.updateHeights();
+        chunk.heights.build(chunk.voxels, indices);
+        chunk.updateRandomUpdateVoxels(indices);
     }
     if (flags & HAS_METADATA) {
         size_t metadataSize = reader.getInt32();
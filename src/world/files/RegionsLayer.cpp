@@ -1,11 +1,23 @@
 #include "WorldRegions.hpp"
 
+#include <zlib.h>
 #include <cstring>
 
+#include "debug/Logger.hpp"
 #include "util/data_io.hpp"
+#include "WorldBackup.hpp"
 
 #define REGION_FORMAT_MAGIC ".VOXREG"
 
+static debug::Logger logger("regions-layer");
+
+/// @brief First region format version with chunks checksums
+static constexpr int CHECKSUMS_VERSION = 4;
+
+static uint32_t calc_checksum(const ubyte* data, uint32_t size) {
+    return crc32(0, data, size);
+}
+
 static io::path get_region_filename(int x, int z) {
     return std::to_string(x) + "_" + std::to_string(z) + ".bin";
 }
@@ -25,7 +37,8 @@ static void fetch_chunks(WorldRegion* region, int x, int z, regfile* file) {
     }
 }
 
-regfile::regfile(io::path filename) : file(std::move(filename)) {
+regfile::regfile(io::path filename)
+    : file(filename), filename(std::move(filename)) {
     if (file.length() < REGION_HEADER_SIZE)
         throw std::runtime_error("incomplete region file header");
     char header[REGION_HEADER_SIZE];
@@ -37,6 +50,7 @@ regfile::regfile(io::path filename) : file(std::move(filename)) {
         throw std::runtime_error("invalid region file magic number");
     }
     version = header[8];
+    compression = static_cast<compression::Method>(header[9]);
     if (static_cast<uint>(version) > REGION_FORMAT_VERSION) {
         throw illegal_region_format(
             "region format " + std::to_string(version) + " is not supported"
@@ -45,16 +59,23 @@ regfile::regfile(io::path filename) : file(std::move(filename)) {
 }
 
 std::unique_ptr<ubyte[]> regfile::read(int index, uint32_t& size, uint32_t& srcSize) {
+    bool hasChecksums = version >= CHECKSUMS_VERSION;
+    size_t entry_size = hasChecksums ? 8 : 4;
     size_t file_size = file.length();
-    size_t table_offset = file_size - REGION_CHUNKS_COUNT * 4;
+    size_t table_offset = file_size - REGION_CHUNKS_COUNT * entry_size;
 
     uint32_t buff32;
-    file.seekg(table_offset + index * 4);
+    file.seekg(table_offset + index * entry_size);
     file.read(reinterpret_cast<char*>(&buff32), 4);
     uint32_t offset = dataio::le2h(buff32);
     if (offset == 0) {
         return nullptr;
     }
+    uint32_t checksum = 0;
+    if (hasChecksums) {
+        file.read(reinterpret_cast<char*>(&buff32), 4);
+        checksum = dataio::le2h(buff32);
+    }
 
     file.seekg(offset);
     file.read(reinterpret_cast<char*>(&buff32), 4);
@@ -62,11 +83,34 @@ std::unique_ptr<ubyte[]> regfile::read(int index, uint32_t& size, uint32_t& srcS
     file.read(reinterpret_cast<char*>(&buff32), 4);
     srcSize = dataio::le2h(buff32);
 
+    if (offset + 8 + static_cast<size_t>(size) > table_offset) {
+        logger.error() << "invalid chunk #" << index << " size in "
+                       << filename.string();
+        return nullptr;
+    }
     auto data = std::make_unique<ubyte[]>(size);
     file.read(reinterpret_cast<char*>(data.get()), size);
+
+    if (hasChecksums && calc_checksum(data.get(), size) != checksum) {
+        quarantine(index, data.get(), size);
+        return nullptr;
+    }
     return data;
 }
 
+void regfile::quarantine(int index, const ubyte* data, uint32_t size) const {
+    auto folder = filename.parent() / "quarantine";
+    auto file = folder / (filename.stem() + "_" + std::to_string(index) + ".bin");
+    logger.error() << "chunk #" << index << " of " << filename.string()
+                   << " is corrupted, moved to " << file.string();
+    try {
+        io::create_directories(folder);
+        io::write_bytes(file, data, size);
+    } catch (const std::exception& err) {
+        logger.error() << "could not write " << file.string() << ": "
+                       << err.what();
+    }
+}
 
 void RegionsLayer::closeRegFile(glm::ivec2 coord) {
     openRegFiles.erase(coord);
@@ -189,7 +233,23 @@ void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
         regfile.reset();
         closeRegFile(regcoord);
     }
+    io::path tmpfile = filename.string() + ".tmp";
+    // previous region file is kept if the write failed
+    writeRegionFile(tmpfile, entry);
+    if (backup) {
+        backup->preserve(filename);
+    }
+    if (!io::rename(tmpfile, filename)) {
+        io::remove(tmpfile);
+        throw std::runtime_error(
+            "could not replace region file " + filename.string()
+        );
+    }
+}
 
+void RegionsLayer::writeRegionFile(
+    const io::path& filename, WorldRegion* entry
+) const {
     char header[REGION_HEADER_SIZE] = REGION_FORMAT_MAGIC;
     header[8] = REGION_FORMAT_VERSION;
     header[9] = static_cast<ubyte>(compression); // FIXME
@@ -199,6 +259,7 @@ void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
     size_t offset = REGION_HEADER_SIZE;
     uint32_t intbuf;
     uint offsets[REGION_CHUNKS_COUNT] {};
+    uint32_t checksums[REGION_CHUNKS_COUNT] {};
 
     auto region = entry->getChunks();
     auto sizes = entry->getSizes();
@@ -213,6 +274,7 @@ void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
         auto sizevec = sizes[i];
         uint32_t compressedSize = sizevec[0];
         uint32_t srcSize = sizevec[1];
+        checksums[i] = calc_checksum(chunk, compressedSize);
         
         intbuf = dataio::h2le(compressedSize);
         file.write(reinterpret_cast<const char*>(&intbuf), 4);
@@ -228,6 +290,16 @@ void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
     for (size_t i = 0; i < REGION_CHUNKS_COUNT; i++) {
         intbuf = dataio::h2le(offsets[i]);
         file.write(reinterpret_cast<const char*>(&intbuf), 4);
+        intbuf = dataio::h2le(checksums[i]);
+        file.write(reinterpret_cast<const char*>(&intbuf), 4);
+    }
+    file.flush();
+    file.close();
+    if (!file.good()) {
+        io::remove(filename);
+        throw std::runtime_error(
+            "could not write region file " + filename.string()
+        );
     }
 }
 
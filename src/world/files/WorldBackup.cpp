@@ -0,0 +1,198 @@
+#include "WorldBackup.hpp"
+
+#include <filesystem>
+
+#include "debug/Logger.hpp"
+#include "util/timeutil.hpp"
+
+static debug::Logger logger("world-backup");
+
+WorldBackup::WorldBackup(io::path source, io::path destination)
+    : source(std::move(source)), destination(std::move(destination)) {
+}
+
+WorldBackup::~WorldBackup() {
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+static bool is_in_folders(
+    const io::path& file, const std::vector<io::path>& folders
+) {
+    auto str = file.string();
+    for (const auto& folder : folders) {
+        auto prefix = folder.string() + "/";
+        if (str.compare(0, prefix.length(), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void list_files(
+    const io::path& root, const io::path& folder, std::vector<io::path>& dst
+) {
+    for (const auto& file : io::directory_iterator(root / folder)) {
+        auto relative = folder / file.name();
+        if (io::is_directory(file)) {
+            list_files(root, relative, dst);
+        } else if (file.extension() != ".tmp") {
+            dst.push_back(relative);
+        }
+    }
+}
+
+size_t WorldBackup::copyFile(const io::path& file) {
+    auto dst = destination / file;
+    io::create_directories(dst.parent());
+    if (!io::copy(source / file, dst)) {
+        throw std::runtime_error("could not copy " + file.string());
+    }
+    return io::file_size(dst);
+}
+
+void WorldBackup::capture(
+    const std::vector<io::path>& deferredFolders, bool hardlinks
+) {
+    if (io::exists(destination)) {
+        throw std::runtime_error(
+            "backup destination " + destination.string() + " already exists"
+        );
+    }
+    std::vector<io::path> files;
+    list_files(source, "", files);
+
+    std::lock_guard lock(mutex);
+    for (const auto& file : files) {
+        if (!is_in_folders(file, deferredFolders)) {
+            stats.bytesCopied += copyFile(file);
+            stats.filesCopied++;
+            continue;
+        }
+        if (hardlinks) {
+            auto dst = destination / file;
+            io::create_directories(dst.parent());
+            std::error_code ec;
+            std::filesystem::create_hard_link(
+                io::resolve(source / file), io::resolve(dst), ec
+            );
+            if (!ec) {
+                stats.filesLinked++;
+                stats.bytesLinked += io::file_size(dst);
+                continue;
+            }
+            logger.warning() << "could not hard-link " << file.string()
+                             << ": " << ec.message()
+                             << ", falling back to copying";
+            hardlinks = false;
+        }
+        pending.insert(file.string());
+    }
+}
+
+void WorldBackup::start() {
+    thread = std::thread([this]() { copyPending(); });
+}
+
+void WorldBackup::copyPending() {
+    timeutil::Timer timer;
+    std::unique_lock lock(mutex);
+    try {
+        while (!pending.empty()) {
+            auto found = pending.begin();
+            inProgress = *found;
+            pending.erase(found);
+            io::path file = inProgress;
+
+            // preserve of other files is not blocked by copying
+            lock.unlock();
+            size_t size = copyFile(file);
+            lock.lock();
+
+            inProgress.clear();
+            stats.filesCopied++;
+            stats.bytesCopied += size;
+            copied.notify_all();
+        }
+    } catch (const std::exception& err) {
+        if (!lock.owns_lock()) {
+            lock.lock();
+        }
+        inProgress.clear();
+        copied.notify_all();
+        logger.error() << "backup " << destination.string()
+                       << " is incomplete: " << err.what();
+    }
+    stats.totalTime = timer.stop() / 1000.0;
+    logger.info() << "backup " << destination.string() << " finished in "
+                  << stats.totalTime << " ms: " << stats.filesCopied
+                  << " files (" << stats.bytesCopied << " bytes) copied, "
+                  << stats.filesLinked << " files (" << stats.bytesLinked
+                  << " bytes) hard-linked, " << stats.filesMoved
+                  << " files (" << stats.bytesMoved << " bytes) moved";
+    finished = true;
+}
+
+void WorldBackup::preserve(const io::path& file) {
+    if (finished) {
+        return;
+    }
+    auto str = file.string();
+    auto prefix = (source / "").string();
+    if (str.compare(0, prefix.length(), prefix) != 0) {
+        return;
+    }
+    io::path relative = str.substr(prefix.length());
+
+    std::unique_lock lock(mutex);
+    copied.wait(lock, [this, &relative]() {
+        return inProgress != relative.string();
+    });
+    auto found = pending.find(relative.string());
+    if (found == pending.end()) {
+        return;
+    }
+    pending.erase(found);
+
+    // the file is replaced or removed next, so the data is not copied
+    auto dst = destination / relative;
+    io::create_directories(dst.parent());
+    std::error_code ec;
+    std::filesystem::create_hard_link(io::resolve(file), io::resolve(dst), ec);
+    if (!ec) {
+        stats.filesLinked++;
+        stats.bytesLinked += io::file_size(dst);
+        return;
+    }
+    if (io::rename(file, dst)) {
+        stats.filesMoved++;
+        stats.bytesMoved += io::file_size(dst);
+        return;
+    }
+    try {
+        stats.bytesCopied += copyFile(relative);
+        stats.filesCopied++;
+    } catch (const std::exception& err) {
+        logger.error() << "backup " << destination.string()
+                       << " is incomplete: " << err.what();
+    }
+}
+
+void WorldBackup::setStallTime(double ms) {
+    std::lock_guard lock(mutex);
+    stats.stallTime = ms;
+}
+
+bool WorldBackup::isFinished() const {
+    return finished;
+}
+
+const io::path& WorldBackup::getDestination() const {
+    return destination;
+}
+
+WorldBackupStats WorldBackup::getStats() {
+    std::lock_guard lock(mutex);
+    return stats;
+}
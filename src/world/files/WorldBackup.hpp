@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "typedefs.hpp"
+#include "io/io.hpp"
+
+/// @brief World backup statistics
+struct WorldBackupStats {
+    /// @brief Time the world was stalled to capture the snapshot (ms)
+    double stallTime = 0.0;
+    /// @brief Time spent until all files were written (ms)
+    double totalTime = 0.0;
+    uint filesCopied = 0;
+    uint filesLinked = 0;
+    /// @brief Files moved to the backup right before being replaced
+    uint filesMoved = 0;
+    size_t bytesCopied = 0;
+    size_t bytesLinked = 0;
+    size_t bytesMoved = 0;
+};
+
+/// @brief Point-in-time copy of a live world directory.
+///
+/// Capture is done on the main thread after the world is saved: region
+/// files are hard-linked (they are replaced by rename and never rewritten
+/// in place) or scheduled for copying in a background thread, other files
+/// are copied immediately. Region file being replaced or removed while
+/// still scheduled is hard-linked or moved to the backup first (see
+/// preserve).
+class WorldBackup {
+    io::path source;
+    io::path destination;
+
+    /// @brief Region files scheduled for copying
+    std::unordered_set<std::string> pending;
+    /// @brief Scheduled file being copied by the background thread or
+    /// empty string
+    std::string inProgress;
+    /// @brief Guards pending files, inProgress and stats. Not held while
+    /// a file is being copied by the background thread
+    std::mutex mutex;
+    /// @brief Notified when inProgress file copying is done
+    std::condition_variable copied;
+    std::thread thread;
+    std::atomic<bool> finished = false;
+    WorldBackupStats stats {};
+
+    /// @return copied file size
+    size_t copyFile(const io::path& file);
+    void copyPending();
+public:
+    /// @param source world directory
+    /// @param destination backup directory, must not exist
+    WorldBackup(io::path source, io::path destination);
+    ~WorldBackup();
+
+    /// @brief Capture world directory state. Scheduled files are copied
+    /// after start
+    /// @param deferredFolders directories with region files (relative to
+    /// the world directory)
+    /// @param hardlinks try to hard-link region files instead of copying
+    /// @throw std::runtime_error if destination already exists
+    void capture(
+        const std::vector<io::path>& deferredFolders, bool hardlinks
+    );
+
+    /// @brief Start copying scheduled files in background
+    void start();
+
+    /// @brief Hard-link or move file to the backup if it is still
+    /// scheduled, copy if neither is possible. Waits if the file is being
+    /// copied. Must be called right before the file gets replaced or removed
+    void preserve(const io::path& file);
+
+    void setStallTime(double ms);
+
+    bool isFinished() const;
+
+    const io::path& getDestination() const;
+
+    /// @brief Get statistics. Totals are final if isFinished() is true
+    WorldBackupStats getStats();
+};
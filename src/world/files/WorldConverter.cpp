@@ -43,6 +43,9 @@ void WorldConverter::addRegionsTasks(
         return;
     }
     for (const auto& file :io::directory_iterator(regionsFolder)) {
+        if (io::is_directory(file) || file.extension() != ".bin") {
+            continue;
+        }
         int x, z;
         std::string name = file.stem();
         if (!WorldRegions::parseRegionFilename(name, x, z)) {
@@ -116,6 +119,15 @@ void WorldConverter::createBlockFieldsConvertTasks() {
     }
 }
 
+void WorldConverter::createRecompressTasks() {
+    for (uint i = 0; i < REGION_LAYERS_COUNT; i++) {
+        addRegionsTasks(
+            static_cast<RegionLayerIndex>(i),
+            ConvertTaskType::RECOMPRESS_REGION
+        );
+    }
+}
+
 WorldConverter::WorldConverter(
     const std::shared_ptr<WorldFiles>& worldFiles,
     const Content* content,
@@ -137,6 +149,9 @@ WorldConverter::WorldConverter(
         case ConvertMode::BLOCK_FIELDS:
             createBlockFieldsConvertTasks();
             break;
+        case ConvertMode::RECOMPRESS:
+            createRecompressTasks();
+            break;
     }
 }
 
@@ -183,8 +198,18 @@ void WorldConverter::upgradeRegion(
     const io::path& file, int x, int z, RegionLayerIndex layer
 ) const {
     auto path = wfile->getRegions().getRegionFilePath(layer, x, z);
-    auto bytes = io::read_bytes_buffer(path);
-    auto buffer = compatibility::convert_region_2to3(bytes, layer);
+    auto buffer = io::read_bytes_buffer(path);
+    if (buffer.size() < REGION_HEADER_SIZE) {
+        throw std::runtime_error("incomplete region file header");
+    }
+    uint version = buffer[8];
+    if (version >= REGION_FORMAT_VERSION) {
+        return;
+    }
+    if (version <= 2) {
+        buffer = compatibility::convert_region_2to3(buffer, layer);
+    }
+    buffer = compatibility::convert_region_3to4(buffer);
     io::write_bytes(path, buffer.data(), buffer.size());
 }
 
@@ -239,6 +264,49 @@ void WorldConverter::convertBlocksData(int x, int z, const ContentReport& report
     });
 }
 
+void WorldConverter::recompressRegion(
+    int x, int z, RegionLayerIndex layer
+) const {
+    RegionRecompression result;
+    try {
+        result = wfile->getRegions().recompressRegion(x, z, layer);
+    } catch (const std::runtime_error& err) {
+        logger.error() << "could not recompress region " << x << "_" << z
+                       << " of layer " << layer << ": " << err.what();
+        std::lock_guard lock(statsMutex);
+        recompressionStats[layer].failed++;
+        return;
+    }
+    std::lock_guard lock(statsMutex);
+    auto& stats = recompressionStats[layer];
+    if (!result.rewritten) {
+        stats.skipped++;
+        return;
+    }
+    stats.regions++;
+    stats.chunks += result.chunks;
+    stats.sizeBefore += result.sizeBefore;
+    stats.sizeAfter += result.sizeAfter;
+}
+
+void WorldConverter::logRecompressionStats() const {
+    std::lock_guard lock(statsMutex);
+    const auto& regions = wfile->getRegions();
+    for (uint i = 0; i < REGION_LAYERS_COUNT; i++) {
+        const auto& stats = recompressionStats[i];
+        if (stats.regions == 0 && stats.skipped == 0 && stats.failed == 0) {
+            continue;
+        }
+        auto name = regions.getRegionsFolder(static_cast<RegionLayerIndex>(i))
+                        .name();
+        logger.info() << "layer '" << name << "': " << stats.regions
+                      << " regions, " << stats.chunks << " chunks, "
+                      << stats.sizeBefore << " -> " << stats.sizeAfter
+                      << " bytes, skipped: " << stats.skipped
+                      << ", failed: " << stats.failed;
+    }
+}
+
 void WorldConverter::convert(const ConvertTask& task) const {
     if (!io::is_regular_file(task.file)) return;
 
@@ -258,6 +326,9 @@ void WorldConverter::convert(const ConvertTask& task) const {
         case ConvertTaskType::CONVERT_BLOCKS_DATA:
             convertBlocksData(task.x, task.z, *report);
             break;
+        case ConvertTaskType::RECOMPRESS_REGION:
+            recompressRegion(task.x, task.z, task.layer);
+            break;
     }
 }
 
@@ -292,6 +363,11 @@ bool WorldConverter::isActive() const {
 }
 
 void WorldConverter::write() {
+    if (mode == ConvertMode::RECOMPRESS) {
+        // region files are replaced during recompression
+        logRecompressionStats();
+        return;
+    }
     logger.info() << "applying changes";
 
     auto patch = dv::object();
@@ -305,6 +381,8 @@ void WorldConverter::write() {
         case ConvertMode::BLOCK_FIELDS:
             WorldFiles::createBlockFieldsIndices(content->getIndices(), patch);
             break;
+        default:
+            break;
     }
     wfile->patchIndicesFile(patch);
     wfile->write(nullptr, nullptr);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <mutex>
 #include <memory>
 #include <queue>
 
@@ -24,6 +26,8 @@ enum class ConvertTaskType {
     UPGRADE_REGION,
     /// @brief convert blocks data to updated layouts
     CONVERT_BLOCKS_DATA,
+    /// @brief convert region file to the layer compression method
+    RECOMPRESS_REGION,
 };
 
 struct ConvertTask {
@@ -39,6 +43,20 @@ enum class ConvertMode {
     UPGRADE,
     REINDEX,
     BLOCK_FIELDS,
+    /// @brief convert regions stored with other compression methods to
+    /// the current layers compression methods
+    RECOMPRESS,
+};
+
+/// @brief Regions layer recompression summary
+struct RecompressionStats {
+    uint regions = 0;
+    /// @brief Regions already using the layer compression method
+    uint skipped = 0;
+    uint failed = 0;
+    uint64_t chunks = 0;
+    uint64_t sizeBefore = 0;
+    uint64_t sizeAfter = 0;
 };
 
 class WorldConverter : public Task {
@@ -50,12 +68,17 @@ class WorldConverter : public Task {
     uint tasksDone = 0;
     ConvertMode mode;
 
+    mutable std::mutex statsMutex;
+    mutable std::array<RecompressionStats, REGION_LAYERS_COUNT>
+        recompressionStats {};
+
     void upgradeRegion(
         const io::path& file, int x, int z, RegionLayerIndex layer) const;
     void convertPlayer(const io::path& file) const;
     void convertVoxels(const io::path& file, int x, int z) const;
     void convertInventories(const io::path& file, int x, int z) const;
     void convertBlocksData(int x, int z, const ContentReport& report) const;
+    void recompressRegion(int x, int z, RegionLayerIndex layer) const;
 
     void addRegionsTasks(
         RegionLayerIndex layerid,
@@ -65,6 +88,8 @@ class WorldConverter : public Task {
     void createUpgradeTasks();
     void createConvertTasks();
     void createBlockFieldsConvertTasks();
+    void createRecompressTasks();
+    void logRecompressionStats() const;
 public:
     WorldConverter(
         const std::shared_ptr<WorldFiles>& worldFiles,
@@ -30,6 +30,7 @@
 #include "voxels/Block.hpp"
 #include "voxels/Chunk.hpp"
 #include "voxels/voxel.hpp"
+#include "WorldBackup.hpp"
 #include "window/Camera.hpp"
 #include "world/World.hpp"
 
@@ -47,6 +48,7 @@ WorldFiles::WorldFiles(const io::path& directory, const DebugSettings& settings)
     doWriteLights = settings.doWriteLights.get();
     regions.generatorTestMode = generatorTestMode;
     regions.doWriteLights = doWriteLights;
+    regions.compactInventories = settings.compactInventories.get();
 }
 
 WorldFiles::~WorldFiles() = default;
@@ -94,6 +96,32 @@ void WorldFiles::write(
     regions.writeAll();
 }
 
+std::shared_ptr<WorldBackup> WorldFiles::createBackup(
+    const io::path& destination, bool hardlinks
+) {
+    if (backup && !backup->isFinished()) {
+        throw std::runtime_error(
+            "backup " + backup->getDestination().string() +
+            " is still in progress"
+        );
+    }
+    regions.setBackup(nullptr);
+    backup.reset();
+
+    std::vector<io::path> regionFolders;
+    for (size_t i = 0; i < REGION_LAYERS_COUNT; i++) {
+        regionFolders.emplace_back(
+            regions.getRegionsFolder(static_cast<RegionLayerIndex>(i)).name()
+        );
+    }
+    auto newBackup = std::make_shared<WorldBackup>(directory, destination);
+    newBackup->capture(regionFolders, hardlinks);
+    newBackup->start();
+    backup = newBackup;
+    regions.setBackup(backup.get());
+    return backup;
+}
+
 void WorldFiles::writePacks(const std::vector<ContentPack>& packs) {
     auto packsFile = getPacksFile();
     std::stringstream ss;
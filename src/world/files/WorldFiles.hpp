@@ -20,12 +20,14 @@ class Player;
 class Content;
 class ContentIndices;
 class World;
+class WorldBackup;
 struct WorldInfo;
 struct DebugSettings;
 
 class WorldFiles {
     io::path directory;
     WorldRegions regions;
+    std::shared_ptr<WorldBackup> backup;
 
     bool generatorTestMode = false;
     bool doWriteLights = true;
@@ -64,6 +66,15 @@ public:
 
     void writePacks(const std::vector<ContentPack>& packs);
 
+    /// @brief Capture backup of the world directory. World must be saved
+    /// before. Region files are hard-linked or copied in background
+    /// @param destination backup directory
+    /// @param hardlinks try to hard-link region files instead of copying
+    /// @throw std::runtime_error if another backup is still in progress
+    std::shared_ptr<WorldBackup> createBackup(
+        const io::path& destination, bool hardlinks
+    );
+
     void removeIndices(const std::vector<std::string>& packs);
 
     /// @return world folder
@@ -12,6 +12,7 @@
 #include "items/Inventory.hpp"
 #include "maths/voxmaths.hpp"
 #include "util/data_io.hpp"
+#include "WorldBackup.hpp"
 
 #define REGION_FORMAT_MAGIC ".VOXREG"
 
@@ -118,14 +119,13 @@ void WorldRegions::put(
 }
 
 static std::unique_ptr<ubyte[]> write_inventories(
-    const ChunkInventoriesMap& inventories, uint32_t& datasize
+    const ChunkInventoriesMap& inventories, uint32_t& datasize, bool compact
 ) {
     ByteBuilder builder;
     builder.putInt32(inventories.size());
     for (auto& entry : inventories) {
         builder.putInt32(entry.first);
-        auto map = entry.second->serialize();
-        auto bytes = json::to_binary(map, true);
+        const auto& bytes = entry.second->encode(compact);
         builder.putInt32(bytes.size());
         builder.put(bytes.data(), bytes.size());
     }
@@ -143,10 +143,9 @@ static ChunkInventoriesMap load_inventories(const ubyte* src, uint32_t size) {
     for (int i = 0; i < count; i++) {
         uint index = reader.getInt32();
         uint size = reader.getInt32();
-        auto map = json::from_binary(reader.pointer(), size);
-        reader.skip(size);
         auto inv = std::make_shared<Inventory>(0, 0);
-        inv->deserialize(map);
+        inv->decode(reader.pointer(), size);
+        reader.skip(size);
         inventories[index] = std::move(inv);
     }
     return inventories;
@@ -185,7 +184,9 @@ void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
     // Writing block inventories
     if (!chunk->inventories.empty()) {
         uint datasize;
-        auto data = write_inventories(chunk->inventories, datasize);
+        auto data = write_inventories(
+            chunk->inventories, datasize, compactInventories
+        );
         put(chunk->x,
             chunk->z,
             REGION_LAYER_INVENTORIES,
@@ -271,7 +272,7 @@ void WorldRegions::processInventories(int x, int z, const InventoryProc& func) {
         for (const auto& [_, inventory] : inventories) {
             func(inventory.get());
         }
-        return write_inventories(inventories, *size);
+        return write_inventories(inventories, *size, compactInventories);
     });
 }
 
@@ -335,6 +336,115 @@ void WorldRegions::processBlocksData(int x, int z, const BlockDataProc& func) {
     }
 }
 
+RegionRecompression WorldRegions::recompressRegion(
+    int x, int z, RegionLayerIndex layerid
+) {
+    auto& layer = layers[layerid];
+    if (layer.getRegion(x, z)) {
+        throw std::runtime_error("not implemented for in-memory regions");
+    }
+    auto path = layer.getRegionFilePath(x, z);
+    RegionRecompression result {};
+    result.sizeBefore = io::file_size(path);
+    result.sizeAfter = result.sizeBefore;
+
+    WorldRegion region;
+    auto chunks = region.getChunks();
+    auto sizes = region.getSizes();
+    {
+        auto regfile = layer.getRegFile({x, z});
+        if (regfile == nullptr) {
+            throw std::runtime_error("could not open region file");
+        }
+        auto stored = regfile.get()->compression;
+        if (stored == layer.compression) {
+            return result;
+        }
+        if (stored > compression::Method::GZIP) {
+            throw std::runtime_error(
+                "unknown compression method " +
+                std::to_string(static_cast<int>(stored))
+            );
+        }
+        for (size_t i = 0; i < REGION_CHUNKS_COUNT; i++) {
+            int gx = (i % REGION_SIZE) + x * REGION_SIZE;
+            int gz = (i / REGION_SIZE) + z * REGION_SIZE;
+            uint32_t length;
+            uint32_t srcSize;
+            auto data = RegionsLayer::readChunkData(
+                gx, gz, length, srcSize, regfile.get()
+            );
+            if (data == nullptr) {
+                continue;
+            }
+            if (stored != compression::Method::NONE) {
+                data = compression::decompress(
+                    data.get(), length, srcSize, stored
+                );
+            }
+            length = srcSize;
+            if (layer.compression != compression::Method::NONE) {
+                size_t size;
+                auto compressed = compression::compress(
+                    data.get(), srcSize, size, layer.compression
+                );
+                auto decompressed = compression::decompress(
+                    compressed.get(), size, srcSize, layer.compression
+                );
+                if (std::memcmp(decompressed.get(), data.get(), srcSize)) {
+                    throw std::runtime_error(
+                        "chunk (" + std::to_string(gx) + ", " +
+                        std::to_string(gz) + ") recompression mismatch"
+                    );
+                }
+                data = std::move(compressed);
+                length = size;
+            }
+            chunks[i] = std::move(data);
+            sizes[i] = glm::u32vec2(length, srcSize);
+            result.chunks++;
+        }
+        std::lock_guard lock(layer.regFilesMutex);
+        regfile.reset();
+        layer.closeRegFile({x, z});
+    }
+
+    io::path tmpfile = path.string() + ".tmp";
+    layer.writeRegionFile(tmpfile, &region);
+    try {
+        regfile written(tmpfile);
+        for (size_t i = 0; i < REGION_CHUNKS_COUNT; i++) {
+            uint32_t length = 0;
+            uint32_t srcSize = 0;
+            auto data = written.read(i, length, srcSize);
+            const auto& expected = sizes[i];
+            bool matches = data == nullptr
+                ? chunks[i] == nullptr
+                : (chunks[i] != nullptr && length == expected[0] &&
+                   srcSize == expected[1] &&
+                   std::memcmp(data.get(), chunks[i].get(), length) == 0);
+            if (!matches) {
+                throw std::runtime_error(
+                    "chunk #" + std::to_string(i) + " verification failed"
+                );
+            }
+        }
+    } catch (const std::runtime_error&) {
+        io::remove(tmpfile);
+        throw;
+    }
+    if (layer.backup) {
+        layer.backup->preserve(path);
+    }
+    if (!io::rename(tmpfile, path)) {
+        io::remove(tmpfile);
+        throw std::runtime_error("could not replace " + path.string());
+    }
+    result.sizeAfter = io::file_size(path);
+    result.rewritten = true;
+    return result;
+}
+
 dv::value WorldRegions::fetchEntities(int x, int z) {
     if (generatorTestMode) {
         return nullptr;
@@ -411,10 +521,19 @@ void WorldRegions::deleteRegion(RegionLayerIndex layerid, int x, int z) {
     auto file = layer.getRegionFilePath(x, z);
     if (io::exists(file)) {
         logger.info() << "remove region file " << file.string();
+        if (layer.backup) {
+            layer.backup->preserve(file);
+        }
         io::remove(file);
     }
 }
 
+void WorldRegions::setBackup(WorldBackup* backup) {
+    for (auto& layer : layers) {
+        layer.backup = backup;
+    }
+}
+
 bool WorldRegions::parseRegionFilename(
     const std::string& name, int& x, int& z
 ) {
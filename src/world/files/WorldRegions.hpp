@@ -18,6 +18,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>
 
+class WorldBackup;
+
 inline constexpr uint REGION_HEADER_SIZE = 10;
 
 inline constexpr uint REGION_SIZE_BIT = 5;
@@ -52,13 +54,23 @@ public:
 
 struct regfile {
     io::rafile file;
+    io::path filename;
     int version;
+    /// @brief Chunks compression method stored in the header
+    compression::Method compression;
     bool inUse = false;
 
     regfile(io::path filename);
     regfile(const regfile&) = delete;
 
+    /// @brief Read chunk data. Chunk data failed checksum verification is
+    /// moved to quarantine folder and treated as missing
+    /// @return nullptr if chunk is not present or corrupted
     std::unique_ptr<ubyte[]> read(int index, uint32_t& size, uint32_t& srcSize);
+private:
+    /// @brief Save corrupted chunk data to 'quarantine' folder next to
+    /// the region file
+    void quarantine(int index, const ubyte* data, uint32_t size) const;
 };
 
 using RegionsMap = std::unordered_map<glm::ivec2, std::unique_ptr<WorldRegion>>;
@@ -135,6 +147,9 @@ struct RegionsLayer {
     std::mutex regFilesMutex;
     std::condition_variable regFilesCv;
 
+    /// @brief Backup in progress, notified before region file is replaced
+    WorldBackup* backup = nullptr;
+
     [[nodiscard]] regfile_ptr getRegFile(glm::ivec2 coord, bool create = true);
     [[nodiscard]] regfile_ptr useRegFile(glm::ivec2 coord);
     regfile_ptr createRegFile(glm::ivec2 coord);
@@ -153,11 +168,19 @@ struct RegionsLayer {
     /// @return nullptr if no saved chunk data found
     [[nodiscard]] ubyte* getData(int x, int z, uint32_t& size, uint32_t& srcSize);
 
-    /// @brief Write or rewrite region file
+    /// @brief Write or rewrite region file. Existing file is replaced
+    /// atomically, so hard links to it keep the previous version
     /// @param x region X
     /// @param z region Z
+    /// @throw std::runtime_error if the file could not be written, existing
+    /// file is left unchanged then
     void writeRegion(int x, int y, WorldRegion* entry);
 
+    /// @brief Write region chunks data to the specified file
+    /// @throw std::runtime_error if the file could not be written, the
+    /// incomplete file is removed then
+    void writeRegionFile(const io::path& filename, WorldRegion* entry) const;
+
     /// @brief Write all unsaved regions to files
     void writeAll();
 
@@ -173,6 +196,18 @@ struct RegionsLayer {
     );
 };
 
+/// @brief Region recompression result
+struct RegionRecompression {
+    /// @brief Region file size before recompression
+    size_t sizeBefore = 0;
+    /// @brief Region file size after recompression
+    size_t sizeAfter = 0;
+    /// @brief Number of chunks rewritten
+    uint chunks = 0;
+    /// @brief Region file is rewritten (was not in the layer compression)
+    bool rewritten = false;
+};
+
 class WorldRegions {
     /// @brief World directory
     io::path directory;
@@ -181,6 +216,9 @@ class WorldRegions {
 public:
     bool generatorTestMode = false;
     bool doWriteLights = true;
+    /// @brief Write inventories in compact binary format instead of
+    /// gzipped binary json
+    bool compactInventories = false;
 
     WorldRegions(const io::path& directory);
     WorldRegions(const WorldRegions&) = delete;
@@ -235,6 +273,19 @@ public:
 
     void processBlocksData(int x, int z, const BlockDataProc& func);
 
+    /// @brief Convert region file chunks from the compression method
+    /// stored in the file header to the layer compression method. Files
+    /// already using the layer method are left unchanged. Every chunk is
+    /// verified to be read back unchanged before replacing the region file
+    /// @param x region X
+    /// @param z region Z
+    /// @param layerid regions layer index
+    /// @throw std::runtime_error if chunk verification failed, region file
+    /// is left unchanged then
+    RegionRecompression recompressRegion(
+        int x, int z, RegionLayerIndex layerid
+    );
+
     /// @brief Get regions directory by layer index
     /// @param layerid layer index
     /// @return directory path
@@ -245,6 +296,11 @@ public:
     /// @brief Write all region layers
     void writeAll();
 
+    /// @brief Set backup to be notified before region files are replaced
+    /// or removed
+    /// @param backup backup in progress or nullptr
+    void setBackup(WorldBackup* backup);
+
     void deleteRegion(RegionLayerIndex layerid, int x, int z);
 
     /// @brief Extract X and Z from 'X_Z.bin' region file name.
@@ -1,5 +1,7 @@
 #include "compatibility.hpp"
 
+#include <zlib.h>
+#include <cstring>
 #include <stdexcept>
 
 #include "constants.hpp"
@@ -107,3 +109,54 @@ util::Buffer<ubyte> compatibility::convert_region_2to3(
     }
     return util::Buffer<ubyte>(builder.build().data(), builder.size());
 }
+
+static uint32_t read_uint32_le(const ubyte* src) {
+    uint32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return dataio::le2h(value);
+}
+
+util::Buffer<ubyte> compatibility::convert_region_3to4(
+    const util::Buffer<ubyte>& src
+) {
+    const size_t REGION_CHUNKS = 1024;
+    const size_t HEADER_SIZE = 10;
+    const size_t OFFSET_TABLE_SIZE = REGION_CHUNKS * sizeof(uint32_t);
+
+    const ubyte* const ptr = src.data();
+    if (src.size() < HEADER_SIZE + OFFSET_TABLE_SIZE) {
+        throw std::runtime_error("incomplete region file");
+    }
+
+    ByteBuilder builder;
+    builder.put(ptr, HEADER_SIZE);
+    builder.set(8, 4);
+
+    uint32_t offsets[REGION_CHUNKS] {};
+    uint32_t checksums[REGION_CHUNKS] {};
+
+    const size_t chunksEnd = src.size() - OFFSET_TABLE_SIZE;
+    const ubyte* tablePtr = ptr + chunksEnd;
+    for (size_t i = 0; i < REGION_CHUNKS; i++) {
+        uint32_t srcOffset = read_uint32_le(tablePtr + i * sizeof(uint32_t));
+        if (srcOffset == 0) {
+            continue;
+        }
+        if (srcOffset + sizeof(uint32_t) * 2 > chunksEnd) {
+            throw std::runtime_error("invalid region chunk offset");
+        }
+        uint32_t size = read_uint32_le(ptr + srcOffset);
+        const ubyte* data = ptr + srcOffset + sizeof(uint32_t) * 2;
+        if (srcOffset + sizeof(uint32_t) * 2 + size > chunksEnd) {
+            throw std::runtime_error("invalid region chunk size");
+        }
+        offsets[i] = builder.size();
+        checksums[i] = crc32(0, data, size);
+        builder.put(ptr + srcOffset, sizeof(uint32_t) * 2 + size);
+    }
+    for (size_t i = 0; i < REGION_CHUNKS; i++) {
+        builder.putInt32(offsets[i]);
+        builder.putInt32(checksums[i]);
+    }
+    return util::Buffer<ubyte>(builder.build().data(), builder.size());
+}
@@ -172,6 +172,17 @@ void VoxelFragment::prepare(const Content& content) {
 
 void VoxelFragment::place(
     GlobalChunks& chunks, const glm::ivec3& offset, ubyte rotation
+) {
+    blocks_agent::EditBatch batch;
+    place(chunks, offset, rotation, batch);
+    blocks_agent::apply(chunks, batch);
+}
+
+void VoxelFragment::place(
+    GlobalChunks& chunks,
+    const glm::ivec3& offset,
+    ubyte rotation,
+    blocks_agent::EditBatch& batch
 ) {
     auto& structVoxels = getRuntimeVoxels();
     for (int y = 0; y < size.y; y++) {
@@ -187,7 +198,13 @@ void VoxelFragment::place(
                     structVoxels[vox_index(x, y, z, size.x, size.z)];
                 if (structVoxel.id) {
                     blocks_agent::set(
-                        chunks, sx, sy, sz, structVoxel.id, structVoxel.state
+                        chunks,
+                        sx,
+                        sy,
+                        sz,
+                        structVoxel.id,
+                        structVoxel.state,
+                        batch
                     );
                 }
             }
@@ -13,6 +13,10 @@ class Level;
 class Content;
 class GlobalChunks;
 
+namespace blocks_agent {
+    struct EditBatch;
+}
+
 class VoxelFragment : public Serializable {
     glm::ivec3 size;
 
@@ -48,6 +52,18 @@ public:
     /// @param rotation rotation index
     void place(GlobalChunks& chunks, const glm::ivec3& offset, ubyte rotation);
 
+    /// @brief Place fragment to the world collecting side effects into
+    /// the edit batch
+    /// @param offset target location
+    /// @param rotation rotation index
+    /// @param batch edit batch
+    void place(
+        GlobalChunks& chunks,
+        const glm::ivec3& offset,
+        ubyte rotation,
+        blocks_agent::EditBatch& batch
+    );
+
     /// @brief Create structure copy rotated 90 deg. clockwise
     std::unique_ptr<VoxelFragment> rotated(const Content& content) const;
 
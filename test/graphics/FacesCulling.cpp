@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "content/Content.hpp"
+#include "graphics/render/FacesCulling.hpp"
+
+TEST(FacesCulling, MasksMatchIsOpen) {
+    Block air("core:air");
+    air.defaults.model.type = BlockModelType::NONE;
+    air.defaults.rt.solid = false;
+    Block stone("base:stone");
+    Block glass("base:glass");
+    glass.defaults.drawGroup = 2;
+    glass.defaults.culling = CullingMode::DISABLED;
+    Block leaves("base:leaves");
+    leaves.defaults.drawGroup = 3;
+    leaves.defaults.culling = CullingMode::OPTIONAL;
+    Block lamp("base:lamp");
+    lamp.defaults.model.type = BlockModelType::CUSTOM;
+    lamp.defaults.rt.solid = false;
+    Block door("base:door");
+    door.size = {1, 2, 1};
+    door.rt.extended = true;
+    // second variant is transparent and has own draw group
+    Block panel("base:panel");
+    panel.variants = std::make_unique<Variants>();
+    panel.variants->offset = 0;
+    panel.variants->mask = 0b11;
+    for (int i = 0; i < 4; i++) {
+        panel.variants->variants.push_back(panel.defaults);
+    }
+    panel.variants->variants[1].rt.solid = false;
+    panel.variants->variants[2].drawGroup = 4;
+    panel.variants->variants[3].culling = CullingMode::DISABLED;
+
+    ContentIndices indices(
+        ContentUnitIndices<Block>(
+            {&air, &stone, &glass, &leaves, &lamp, &door, &panel}
+        ),
+        ContentUnitIndices<ItemDef>(std::vector<ItemDef*>()),
+        ContentUnitIndices<EntityDef>(std::vector<EntityDef*>())
+    );
+    const auto& defs = indices.blocks.getIterable();
+    for (size_t id = 0; id < defs.size(); id++) {
+        defs[id]->rt.id = id;
+    }
+
+    const int pad = 2;
+    VoxelsVolume volume(
+        -pad, 0, -pad, CHUNK_W + pad * 2, CHUNK_H, CHUNK_D + pad * 2
+    );
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    };
+    voxel* voxels = volume.getVoxels();
+    for (int y = 0; y < volume.getH(); y++) {
+        for (int z = 0; z < volume.getD(); z++) {
+            for (int x = 0; x < volume.getW(); x++) {
+                auto& vox = voxels[vox_index(
+                    x, y, z, volume.getW(), volume.getD()
+                )];
+                vox.state = {};
+                // missing neighbour chunks at -X and +Z sides
+                if (x < pad || z >= pad + CHUNK_D) {
+                    vox.id = BLOCK_VOID;
+                    continue;
+                }
+                vox.id = next() % 3 ? next() % defs.size() : 0;
+                if (vox.id == door.rt.id) {
+                    vox.state.segment = next() % 2;
+                } else if (vox.id == panel.rt.id) {
+                    vox.state.userbits = next() % 4;
+                }
+            }
+        }
+    }
+
+    FacesCulling culling(indices, volume, pad);
+    culling.build(0, CHUNK_H);
+
+    const glm::ivec3 dirs[6] {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}
+    };
+    for (int y = 0; y < CHUNK_H; y++) {
+        for (int z = 0; z < CHUNK_D; z++) {
+            for (int x = 0; x < CHUNK_W; x++) {
+                glm::ivec3 coord(x, y, z);
+                const auto& vox = voxels[vox_index(
+                    x + pad, y, z + pad, volume.getW(), volume.getD()
+                )];
+                const auto& def = *defs[vox.id];
+                const auto& variant = def.getVariantByBits(vox.state.userbits);
+                for (bool densePass : {false, true}) {
+                    for (const auto& dir : dirs) {
+                        ASSERT_EQ(
+                            culling.isFaceOpen(
+                                coord, dir, def, variant, densePass
+                            ),
+                            culling.isOpen(coord + dir, def, variant, densePass)
+                        ) << "at " << x << " " << y << " " << z
+                          << " dir " << dir.x << " " << dir.y << " " << dir.z
+                          << " dense " << densePass;
+                    }
+                }
+            }
+        }
+    }
+}
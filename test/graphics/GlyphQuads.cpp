@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "graphics/core/GlyphQuads.hpp"
+
+TEST(GlyphQuads, Build) {
+    FontStylesScheme styles {
+        {FontStyle(), FontStyle(true, false, false, true, {1, 0, 0, 1})},
+        {0, 0, 1}
+    };
+    std::vector<GlyphQuad> quads;
+    // cyrillic glyph is on the next codepage
+    build_glyph_quads(quads, L"a\u0436 b", &styles, 0);
+
+    // 'a', ' ' skipped, 'b' bold (2 passes), then page 4, then underline
+    // of ' ' and 'b' (lines are always bold)
+    ASSERT_EQ(quads.size(), 8);
+    EXPECT_EQ(quads[0].codepoint, 'a');
+    EXPECT_EQ(quads[1].codepoint, 'b');
+    EXPECT_EQ(quads[1].offset.x, 3);
+    EXPECT_EQ(quads[1].boldPass, 0);
+    EXPECT_EQ(quads[2].boldPass, 1);
+    EXPECT_EQ(quads[2].color, glm::vec4(1, 0, 0, 1));
+    EXPECT_EQ(quads[3].codepoint, 0x436);
+    EXPECT_EQ(quads[3].offset.x, 1);
+    EXPECT_EQ(quads[4].codepoint, '_');
+    EXPECT_EQ(quads[4].offset.x, 2);
+    EXPECT_EQ(quads[5].boldPass, 1);
+    EXPECT_EQ(quads[7].offset.x, 3);
+}
+
+TEST(GlyphQuads, Cache) {
+    GlyphQuadsCache cache(2);
+    FontStylesScheme styles {
+        {FontStyle(), FontStyle(true, false, false, false, {1, 1, 1, 1})},
+        {0, 1}
+    };
+
+    EXPECT_EQ(cache.get(L"hello", nullptr, 0).size(), 5);
+    EXPECT_EQ(cache.get(L"hello", nullptr, 0).size(), 5);
+    EXPECT_EQ(cache.getStats().hits, 1);
+
+    // same text with other styles replaces the entry
+    EXPECT_EQ(cache.get(L"hello", &styles, 0).size(), 9);
+    EXPECT_EQ(cache.get(L"hello", &styles, 1).size(), 10);
+    EXPECT_EQ(cache.get(L"hello", &styles, 1).size(), 10);
+    EXPECT_EQ(cache.getStats().hits, 2);
+    EXPECT_EQ(cache.getStats().misses, 3);
+
+    // least recently used entry is evicted
+    cache.get(L"first", nullptr, 0);
+    cache.get(L"second", nullptr, 0);
+    cache.get(L"first", nullptr, 0);
+    cache.get(L"third", nullptr, 0);
+    EXPECT_EQ(cache.size(), 2);
+    size_t misses = cache.getStats().misses;
+    cache.get(L"first", nullptr, 0);
+    EXPECT_EQ(cache.getStats().misses, misses);
+    cache.get(L"second", nullptr, 0);
+    EXPECT_EQ(cache.getStats().misses, misses + 1);
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "graphics/render/TextNotesIndex.hpp"
+#include "maths/FrustumCulling.hpp"
+
+static bool contains(const std::vector<u64id_t>& ids, u64id_t id) {
+    return std::find(ids.begin(), ids.end(), id) != ids.end();
+}
+
+TEST(TextNotesIndex, Query) {
+    // camera at origin looking to -Z
+    Frustum frustum;
+    frustum.update(
+        glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 1000.0f) *
+        glm::lookAt(glm::vec3(0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0))
+    );
+    glm::vec3 camera(0.0f);
+
+    TextNotesIndex index;
+    index.set(1, {{0, 0, -10}, 32.0f, 1.0f});
+    index.set(2, {{0, 0, -100}, 32.0f, 1.0f}); // too far
+    index.set(3, {{0, 0, 10}, 32.0f, 1.0f});   // behind
+    index.set(4, {{0, 0, 10}, 32.0f, -1.0f});  // behind, billboard
+    EXPECT_EQ(index.size(), 4);
+
+    std::vector<u64id_t> ids;
+    index.query(ids, camera, 1.0f, frustum);
+    EXPECT_TRUE(contains(ids, 1));
+    EXPECT_FALSE(contains(ids, 2));
+    EXPECT_TRUE(contains(ids, 4));
+
+    // behind bucket is culled without the billboard
+    index.remove(4);
+    index.query(ids, camera, 1.0f, frustum);
+    EXPECT_EQ(ids, std::vector<u64id_t> {1});
+
+    // zoom decreases render distance
+    index.query(ids, camera, 4.0f, frustum);
+    EXPECT_TRUE(ids.empty());
+
+    // moved into view
+    index.set(2, {{0, 0, -20}, 32.0f, 1.0f});
+    index.query(ids, camera, 1.0f, frustum);
+    EXPECT_TRUE(contains(ids, 1));
+    EXPECT_TRUE(contains(ids, 2));
+    EXPECT_EQ(ids.size(), 2);
+
+    index.remove(1);
+    index.remove(2);
+    index.remove(3);
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.countBuckets(), 0);
+}
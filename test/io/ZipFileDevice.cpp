@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#define ZLIB_CONST
+#include <zlib.h>
+#include <tuple>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <sstream>
+#include <cstring>
+
+#include "io/devices/ZipFileDevice.hpp"
+#include "coders/byte_utils.hpp"
+
+static std::string deflate_raw(const std::string& src) {
+    z_stream zstream {};
+    deflateInit2(
+        &zstream, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY
+    );
+    std::string dst(deflateBound(&zstream, src.size()), '\0');
+    zstream.next_in = reinterpret_cast<const Bytef*>(src.data());
+    zstream.avail_in = src.size();
+    zstream.next_out = reinterpret_cast<Bytef*>(dst.data());
+    zstream.avail_out = dst.size();
+    deflate(&zstream, Z_FINISH);
+    dst.resize(zstream.total_out);
+    deflateEnd(&zstream);
+    return dst;
+}
+
+static void put_string(ByteBuilder& builder, const std::string& s) {
+    builder.put(reinterpret_cast<const ubyte*>(s.data()), s.length());
+}
+
+/// @brief Build ZIP archive with given entries (name, content, deflate)
+static std::string build_zip(
+    const std::vector<std::tuple<std::string, std::string, bool>>& files
+) {
+    ByteBuilder out;
+    ByteBuilder central_dir;
+    for (const auto& [name, content, compress] : files) {
+        auto data = compress ? deflate_raw(content) : content;
+        uint32_t crc = crc32(
+            0, reinterpret_cast<const Bytef*>(content.data()), content.size()
+        );
+        size_t local_header_offset = out.size();
+        out.putInt32(0x04034b50);
+        out.putInt16(10); // version
+        out.putInt16(0); // flags
+        out.putInt16(compress ? 8 : 0);
+        out.putInt32(0); // last modification datetime
+        out.putInt32(crc);
+        out.putInt32(data.size());
+        out.putInt32(content.size());
+        out.putInt16(name.length());
+        out.putInt16(0); // extra field length
+        put_string(out, name);
+        put_string(out, data);
+
+        central_dir.putInt32(0x02014b50);
+        central_dir.putInt16(10); // version made by
+        central_dir.putInt16(10); // version needed
+        central_dir.putInt16(0); // flags
+        central_dir.putInt16(compress ? 8 : 0);
+        central_dir.putInt32(0); // last modification datetime
+        central_dir.putInt32(crc);
+        central_dir.putInt32(data.size());
+        central_dir.putInt32(content.size());
+        central_dir.putInt16(name.length());
+        central_dir.putInt16(0); // extra field length
+        central_dir.putInt16(0); // file comment length
+        central_dir.putInt16(0); // disk number start
+        central_dir.putInt16(0); // internal attributes
+        central_dir.putInt32(0); // external attributes
+        central_dir.putInt32(local_header_offset);
+        put_string(central_dir, name);
+    }
+    size_t central_dir_offset = out.size();
+    out.put(central_dir.data(), central_dir.size());
+    out.putInt32(0x06054b50);
+    out.putInt16(0); // disk number
+    out.putInt16(0); // central dir disk
+    out.putInt16(files.size());
+    out.putInt16(files.size());
+    out.putInt32(central_dir.size());
+    out.putInt32(central_dir_offset);
+    out.putInt16(0); // comment length
+    return std::string(reinterpret_cast<const char*>(out.data()), out.size());
+}
+
+static std::string read_all(std::istream& stream) {
+    std::stringstream ss;
+    ss << stream.rdbuf();
+    return ss.str();
+}
+
+TEST(io, ZipFileDeviceRead) {
+    std::string text;
+    for (int i = 0; i < 1000; i++) {
+        text += "line " + std::to_string(i) + "\n";
+    }
+    std::string large(io::ZipFileDevice::MAX_CACHED_ENTRY_SIZE + 1, 'x');
+    auto zip = build_zip({
+        {"text.txt", text, true},
+        {"dir/stored.bin", "stored content", false},
+        {"large.txt", large, true},
+    });
+    io::ZipFileDevice device(std::make_unique<std::istringstream>(zip));
+
+    EXPECT_TRUE(device.isdir("dir"));
+    EXPECT_TRUE(device.isfile("dir/stored.bin"));
+    EXPECT_EQ(device.size("text.txt"), text.size());
+    EXPECT_THROW(device.read("dir"), std::runtime_error);
+    EXPECT_THROW(device.read("missing.txt"), std::runtime_error);
+
+    // second read is served from the inflated entries cache
+    for (int i = 0; i < 2; i++) {
+        EXPECT_EQ(read_all(*device.read("text.txt")), text);
+    }
+    EXPECT_EQ(read_all(*device.read("dir/stored.bin")), "stored content");
+    EXPECT_EQ(read_all(*device.read("large.txt")), large);
+}
+
+TEST(io, ZipFileDeviceConcurrentRead) {
+    std::vector<std::tuple<std::string, std::string, bool>> files;
+    for (int i = 0; i < 16; i++) {
+        files.emplace_back(
+            "file" + std::to_string(i) + ".txt",
+            std::string(1000 + i * 100, 'a' + i),
+            i % 2 == 0
+        );
+    }
+    io::ZipFileDevice device(
+        std::make_unique<std::istringstream>(build_zip(files))
+    );
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures = 0;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (int n = 0; n < 50; n++) {
+                for (const auto& [name, content, _] : files) {
+                    if (read_all(*device.read(name)) != content) {
+                        failures++;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(failures, 0);
+}
+
+TEST(io, ZipFileDeviceEntryBounds) {
+    auto zip = build_zip({{"file.txt", "content", false}});
+    // central directory entry is followed by the file name and EOCD
+    size_t entry_offset = zip.size() - 22 - 46 - std::strlen("file.txt");
+    auto patch = [&](size_t offset, uint32_t value) {
+        auto patched = zip;
+        for (int i = 0; i < 4; i++) {
+            patched[entry_offset + offset + i] = (value >> (i * 8)) & 0xFF;
+        }
+        return std::make_unique<std::istringstream>(patched);
+    };
+    EXPECT_NO_THROW(io::ZipFileDevice(patch(20, 7)));
+    // compressed size
+    EXPECT_THROW(io::ZipFileDevice(patch(20, 1000)), std::runtime_error);
+    EXPECT_THROW(io::ZipFileDevice(patch(20, 0xFFFFFFFF)), std::runtime_error);
+    // local header offset
+    EXPECT_THROW(io::ZipFileDevice(patch(42, zip.size())), std::runtime_error);
+    EXPECT_THROW(io::ZipFileDevice(patch(42, 0xFFFFFFF0)), std::runtime_error);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <utility>
+
+#include "coders/binary_json.hpp"
+#include "content/Content.hpp"
+#include "items/Inventory.hpp"
+#include "items/ItemDef.hpp"
+
+static void check_equal(const Inventory& a, const Inventory& b) {
+    EXPECT_EQ(a.getId(), b.getId());
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        const auto& x = a.getSlot(i);
+        const auto& y = b.getSlot(i);
+        EXPECT_EQ(x.getItemId(), y.getItemId());
+        EXPECT_EQ(x.getCount(), y.getCount());
+        ASSERT_EQ(x.hasFields(), y.hasFields());
+        if (x.hasFields()) {
+            EXPECT_EQ(
+                json::to_binary(x.getFields()), json::to_binary(y.getFields())
+            );
+        }
+    }
+}
+
+TEST(Inventory, EncodeDecode) {
+    Inventory inventory(42, 10);
+    inventory.getSlot(1).set(ItemStack(5, 64));
+    inventory.getSlot(7).set(ItemStack(3, 1));
+    inventory.getSlot(7).setField("uses", 12);
+
+    for (bool compact : {true, false}) {
+        const auto& bytes = inventory.encode(compact);
+        Inventory decoded(0, 0);
+        decoded.decode(bytes.data(), bytes.size());
+        check_equal(inventory, decoded);
+    }
+    // empty slots take one byte
+    EXPECT_LT(inventory.encode(true).size(), 64);
+}
+
+TEST(Inventory, EncodedCache) {
+    Inventory inventory(1, 4);
+    inventory.getSlot(0).set(ItemStack(2, 3));
+
+    const auto* data = inventory.encode(true).data();
+    EXPECT_FALSE(inventory.isDirty());
+
+    const Inventory& constref = inventory;
+    EXPECT_EQ(constref.getSlot(0).getCount(), 3);
+    EXPECT_FALSE(inventory.isDirty());
+    EXPECT_EQ(inventory.encode(true).data(), data);
+
+    inventory.getSlot(0).setCount(2);
+    EXPECT_TRUE(inventory.isDirty());
+    auto bytes = inventory.encode(true);
+    Inventory decoded(0, 0);
+    decoded.decode(bytes.data(), bytes.size());
+    EXPECT_EQ(decoded.getSlot(0).getCount(), 2);
+}
+
+TEST(Inventory, DecodeLegacy) {
+    Inventory inventory(7, 3);
+    inventory.getSlot(2).set(ItemStack(9, 5));
+    auto bytes = json::to_binary(inventory.serialize(), true);
+
+    Inventory decoded(0, 0);
+    decoded.decode(bytes.data(), bytes.size());
+    check_equal(inventory, decoded);
+}
+
+static size_t find_by_item_linear(
+    const Inventory& inventory, itemid_t id, size_t begin, size_t minCount
+) {
+    for (size_t i = begin; i < inventory.size(); i++) {
+        const auto& slot = inventory.getSlot(i);
+        if (slot.getItemId() == id && slot.getCount() >= minCount) {
+            return i;
+        }
+    }
+    return Inventory::npos;
+}
+
+TEST(Inventory, IndexedLookups) {
+    const size_t size = Inventory::INDEXED_MIN_SIZE * 3 + 5;
+    Inventory inventory(1, size);
+    const Inventory& constref = inventory;
+
+    uint32_t seed = 1;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    };
+    for (int step = 0; step < 2000; step++) {
+        // direct slot edits are re-indexed on the next lookup
+        auto& slot = inventory.getSlot(next() % size);
+        itemid_t id = next() % 4;
+        slot.set(ItemStack(id, id ? next() % 8 + 1 : 0));
+
+        size_t begin = next() % size;
+        size_t expectedFree = Inventory::npos;
+        for (size_t i = begin; i < size; i++) {
+            if (constref.getSlot(i).isEmpty()) {
+                expectedFree = i;
+                break;
+            }
+        }
+        ASSERT_EQ(inventory.findEmptySlot(begin), expectedFree);
+
+        itemid_t query = next() % 3 + 1;
+        size_t minCount = next() % 4 + 1;
+        ASSERT_EQ(
+            inventory.findSlotByItem(query, begin, -1, minCount),
+            find_by_item_linear(inventory, query, begin, minCount)
+        );
+    }
+    inventory.resize(10);
+    EXPECT_EQ(inventory.findEmptySlot(10), Inventory::npos);
+}
+
+TEST(Inventory, IndexedMove) {
+    ItemDef empty("core:empty");
+    ItemDef stone("base:stone.item");
+    ItemDef pickaxe("base:pickaxe");
+    pickaxe.stackSize = 1;
+    ContentIndices indices(
+        ContentUnitIndices<Block>(std::vector<Block*>()),
+        ContentUnitIndices<ItemDef>({&empty, &stone, &pickaxe}),
+        ContentUnitIndices<EntityDef>(std::vector<EntityDef*>())
+    );
+    const size_t size = Inventory::INDEXED_MIN_SIZE * 2;
+    Inventory inventory(1, size);
+    inventory.getSlot(3).set(ItemStack(1, 60));
+    inventory.getSlot(5).set(ItemStack(2, 1));
+    inventory.getSlot(size - 1).set(ItemStack(1, 10));
+
+    // fills existing stacks first, then empty slots
+    ItemStack item(1, 100);
+    inventory.move(item, indices);
+    EXPECT_TRUE(item.isEmpty());
+    EXPECT_EQ(inventory.getSlot(3).getCount(), 64);
+    EXPECT_EQ(inventory.getSlot(size - 1).getCount(), 64);
+    EXPECT_EQ(inventory.getSlot(0).getCount(), 42);
+    EXPECT_TRUE(inventory.getSlot(1).isEmpty());
+
+    // moving a slot within the same inventory updates the source slot
+    inventory.getSlot(0).setCount(20);
+    inventory.move(inventory.getSlot(5), indices, 6);
+    EXPECT_EQ(inventory.findSlotByItem(2), 6);
+    EXPECT_EQ(inventory.findEmptySlot(), 1);
+    EXPECT_EQ(inventory.findEmptySlot(5), 5);
+    EXPECT_EQ(inventory.findSlotByItem(1, 0, -1, 20), 0);
+
+    // compare with linear move
+    std::vector<ItemStack> expected(size);
+    for (size_t i = 0; i < size; i++) {
+        expected[i] = inventory.getSlot(i);
+    }
+    uint32_t seed = 7;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7FFF;
+    };
+    for (int step = 0; step < 1000; step++) {
+        size_t index = next() % size;
+        ItemStack stack(next() % 2 + 1, next() % 3 ? 1 : 0);
+        expected[index] = stack;
+        inventory.getSlot(index) = stack;
+
+        itemid_t id = next() % 2 + 1;
+        itemcount_t count = next() % 100 + 1;
+        size_t begin = next() % size;
+        size_t end = begin + next() % size;
+        ItemStack item(id, count);
+        ItemStack expectedItem(id, count);
+        inventory.move(item, indices, begin, end);
+        for (int pass = 0; pass < 2; pass++) {
+            for (size_t i = begin; i < std::min(size, end); i++) {
+                auto& slot = expected[i];
+                if ((pass || !slot.isEmpty()) && slot.accepts(expectedItem) &&
+                    !expectedItem.isEmpty()) {
+                    slot.move(expectedItem, indices);
+                }
+            }
+        }
+        ASSERT_EQ(item.getCount(), expectedItem.getCount());
+        for (size_t i = 0; i < size; i++) {
+            const auto& slot = std::as_const(inventory).getSlot(i);
+            ASSERT_EQ(slot.getItemId(), expected[i].getItemId());
+            ASSERT_EQ(slot.getCount(), expected[i].getCount());
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include "coders/commons.hpp"
+#include "logic/CommandsInterpreter.hpp"
+
+using namespace cmd;
+
+static dv::value return_args(
+    CommandsInterpreter*, const dv::value& args, const dv::value& kwargs
+) {
+    auto result = dv::list();
+    for (const auto& arg : args) {
+        result.add(arg);
+    }
+    result.add(kwargs);
+    return result;
+}
+
+TEST(CommandsInterpreter, PromptsCache) {
+    CommandsInterpreter interpreter;
+    auto repo = interpreter.getRepository();
+    repo->add("tp entity:sel=$entity.id x:num~pos.x", "", return_args);
+    repo->add(
+        "mode value:[replace|destruct|none] {depth:int=1}", "", return_args
+    );
+    interpreter["entity.id"] = 5;
+    interpreter["pos.x"] = 10.0;
+    const auto& stats = interpreter.getCache().getStats();
+
+    auto result = interpreter.execute("tp ~1");
+    EXPECT_EQ(result[0].asInteger(), 5);
+    EXPECT_EQ(result[1].asNumber(), 11.0);
+    interpreter.execute("tp ~1");
+    EXPECT_EQ(stats.hits, 1);
+
+    // used variable changed
+    interpreter["pos.x"] = 20.0;
+    EXPECT_EQ(interpreter.execute("tp ~1")[1].asNumber(), 21.0);
+    EXPECT_EQ(stats.hits, 1);
+    interpreter.execute("tp ~1");
+    EXPECT_EQ(stats.hits, 2);
+
+    // selector is resolved to object id
+    EXPECT_EQ(interpreter.execute("tp @12 0")[0].asInteger(), 12);
+    EXPECT_THROW(interpreter.execute("tp @x 0"), parsing_error);
+
+    EXPECT_EQ(interpreter.execute("mode destruct")[0].asString(), "destruct");
+    EXPECT_EQ(
+        interpreter.execute("mode replace depth=4")[1]["depth"].asInteger(), 4
+    );
+    EXPECT_THROW(interpreter.execute("mode destr"), parsing_error);
+
+    // repository change invalidates cached prompts
+    EXPECT_GT(interpreter.getCache().size(), 0);
+    repo->add("mode value:[replace|none]", "", return_args);
+    EXPECT_THROW(interpreter.execute("mode destruct"), parsing_error);
+    EXPECT_EQ(interpreter.getCache().size(), 0);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <cstring>
+
+#include "logic/scripting/lua/lua_allocator.hpp"
+#include "logic/scripting/lua/lua_commons.hpp"
+
+using lua::Allocator;
+
+static void fill(void* ptr, size_t size) {
+    auto bytes = reinterpret_cast<uint8_t*>(ptr);
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+}
+
+static bool check(const void* ptr, size_t size) {
+    auto bytes = reinterpret_cast<const uint8_t*>(ptr);
+    for (size_t i = 0; i < size; i++) {
+        if (bytes[i] != static_cast<uint8_t>(i * 7 + 3)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(lua_allocator, Reallocate) {
+    Allocator allocator;
+    void* ptr = allocator.reallocate(nullptr, 0, 10);
+    ASSERT_NE(ptr, nullptr);
+    fill(ptr, 10);
+
+    // same size class keeps the block
+    EXPECT_EQ(allocator.reallocate(ptr, 10, 16), ptr);
+    fill(ptr, 16);
+    EXPECT_EQ(allocator.getUsedBytes(), 16);
+
+    // other size classes
+    ptr = allocator.reallocate(ptr, 16, 17);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(check(ptr, 16));
+    fill(ptr, 17);
+    ptr = allocator.reallocate(ptr, 17, Allocator::MAX_POOLED_SIZE);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(check(ptr, 17));
+    fill(ptr, Allocator::MAX_POOLED_SIZE);
+
+    // pooled to large and large to large
+    size_t large = Allocator::MAX_POOLED_SIZE + 1;
+    ptr = allocator.reallocate(ptr, Allocator::MAX_POOLED_SIZE, large);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(check(ptr, Allocator::MAX_POOLED_SIZE));
+    fill(ptr, large);
+    ptr = allocator.reallocate(ptr, large, 4000);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(check(ptr, large));
+    fill(ptr, 4000);
+    EXPECT_EQ(allocator.getUsedBytes(), 4000);
+
+    // large to pooled keeps the head
+    ptr = allocator.reallocate(ptr, 4000, 100);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(check(ptr, 100));
+    EXPECT_EQ(allocator.getUsedBytes(), 100);
+
+    // shrinking to 0 frees the block
+    EXPECT_EQ(allocator.reallocate(ptr, 100, 0), nullptr);
+    EXPECT_EQ(allocator.getUsedBytes(), 0);
+    // both blocks are allocated while moving to the pool
+    EXPECT_EQ(allocator.getPeakBytes(), 4100);
+    EXPECT_EQ(allocator.reallocate(nullptr, 0, 0), nullptr);
+}
+
+TEST(lua_allocator, PagesReuse) {
+    Allocator allocator;
+    const size_t size = 64;
+    const size_t count = Allocator::PAGE_SIZE / size + 10;
+
+    std::set<void*> blocks;
+    for (size_t i = 0; i < count; i++) {
+        void* ptr = allocator.allocate(size);
+        ASSERT_NE(ptr, nullptr);
+        fill(ptr, size);
+        blocks.insert(ptr);
+    }
+    EXPECT_EQ(blocks.size(), count);
+    EXPECT_EQ(allocator.getPagesBytes(), Allocator::PAGE_SIZE * 2);
+    for (void* ptr : blocks) {
+        EXPECT_TRUE(check(ptr, size));
+        allocator.deallocate(ptr, size);
+    }
+    EXPECT_EQ(allocator.getUsedBytes(), 0);
+
+    // freed blocks of the size class are taken first
+    for (size_t i = 0; i < count; i++) {
+        void* ptr = allocator.allocate(size - 10);
+        EXPECT_TRUE(blocks.find(ptr) != blocks.end());
+    }
+    EXPECT_EQ(allocator.getPagesBytes(), Allocator::PAGE_SIZE * 2);
+
+    // other size class does not use them
+    void* ptr = allocator.allocate(size + 1);
+    EXPECT_TRUE(blocks.find(ptr) == blocks.end());
+}
+
+TEST(lua_allocator, LuaState) {
+    Allocator allocator;
+    auto L = lua_newstate(Allocator::alloc, &allocator);
+    if (L == nullptr) {
+        GTEST_SKIP() << "custom allocators are not supported by the build";
+    }
+    luaL_openlibs(L);
+    ASSERT_EQ(
+        luaL_dostring(
+            L,
+            "garbage = {}\n"
+            "for i = 1, 10000 do\n"
+            "    garbage[i] = {i, tostring(i), string.rep('x', i % 1000)}\n"
+            "end\n"
+            "garbage = nil\n"
+        ),
+        0
+    );
+    size_t used = allocator.getUsedBytes();
+    EXPECT_GT(used, 0);
+    EXPECT_GE(allocator.getPeakBytes(), used);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    EXPECT_LT(allocator.getUsedBytes(), used);
+    lua_close(L);
+    EXPECT_EQ(allocator.getUsedBytes(), 0);
+}
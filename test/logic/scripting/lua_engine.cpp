@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include "io/io.hpp"
+#include "io/engine_paths.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "logic/scripting/lua/lua_engine.hpp"
+#include "logic/scripting/lua/lua_util.hpp"
+
+TEST(lua_engine, WorkerLibs) {
+    io::set_device("res", std::make_shared<io::StdfsDevice>("res", false));
+    io::create_subdevice("core", "res", "");
+    EnginePaths paths;
+    auto L = lua::create_state(paths, lua::StateType::WORKER);
+
+    for (const auto& name : {"block", "item", "generation", "pack", "world",
+                             "player", "inventory", "entities"}) {
+        EXPECT_FALSE(lua::hasglobal(L, name)) << name;
+    }
+    for (const auto& name : {"base64", "bjson", "byteutil", "json", "toml",
+                             "utf8", "vec2", "vec3", "vec4", "mat4", "quat",
+                             "yaml"}) {
+        EXPECT_TRUE(lua::hasglobal(L, name)) << name;
+    }
+    // only read-only functions required to load modules are available
+    ASSERT_TRUE(lua::getglobal(L, "file"));
+    EXPECT_TRUE(lua::hasfield(L, "read"));
+    EXPECT_FALSE(lua::hasfield(L, "write"));
+    EXPECT_FALSE(lua::hasfield(L, "remove"));
+    lua::pop(L);
+    lua::close(L);
+
+    io::remove_device("core");
+    io::remove_device("res");
+}
@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "maths/Heightmap.hpp"
+
+// Reference per-pixel implementation the resize kernels are checked against
+
+static float ref_sample(
+    const std::vector<float>& buffer, uint width, uint height, uint x, uint y
+) {
+    return buffer[(y >= height ? height - 1 : y) * width +
+                  (x >= width ? width - 1 : x)];
+}
+
+static float ref_cubic(const float p[4], float x) {
+    return p[1] + 0.5 * x*(p[2] - p[0] + x*(2.0*p[0] - 5.0*p[1] + 4.0*p[2] -
+           p[3] + x*(3.0*(p[1] - p[2]) + p[3] - p[0])));
+}
+
+static std::vector<float> ref_resize(
+    const std::vector<float>& src,
+    uint width,
+    uint height,
+    uint dstwidth,
+    uint dstheight,
+    InterpolationType interp
+) {
+    std::vector<float> dst(dstwidth * dstheight);
+    for (uint y = 0; y < dstheight; y++) {
+        for (uint x = 0; x < dstwidth; x++) {
+            float sx = static_cast<float>(x) / dstwidth * width;
+            float sy = static_cast<float>(y) / dstheight * height;
+            uint ix = static_cast<uint>(sx);
+            uint iy = static_cast<uint>(sy);
+            float tx = sx - ix;
+            float ty = sy - iy;
+            float& out = dst[y * dstwidth + x];
+            if (interp == InterpolationType::NEAREST) {
+                out = src[iy * width + ix];
+            } else if (interp == InterpolationType::LINEAR) {
+                float s00 = ref_sample(src, width, height, ix, iy);
+                float s10 = ref_sample(src, width, height, ix + 1, iy);
+                float s01 = ref_sample(src, width, height, ix, iy + 1);
+                float s11 = ref_sample(src, width, height, ix + 1, iy + 1);
+                out = s00 + (s10 - s00) * tx + (s01 - s00) * ty +
+                      (s11 - s10 - s01 + s00) * tx * ty;
+            } else {
+                float q[4];
+                for (int i = 0; i < 4; i++) {
+                    float p[4];
+                    for (int j = 0; j < 4; j++) {
+                        p[j] = ref_sample(
+                            src, width, height, ix + j - 1, iy + i - 1
+                        );
+                    }
+                    q[i] = ref_cubic(p, tx);
+                }
+                out = ref_cubic(q, ty);
+            }
+        }
+    }
+    return dst;
+}
+
+static void check_resize(
+    uint width,
+    uint height,
+    uint dstwidth,
+    uint dstheight,
+    InterpolationType interp
+) {
+    std::mt19937 random(width * 31 + height);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> values(width * height);
+    for (auto& value : values) {
+        value = distribution(random);
+    }
+    auto expected =
+        ref_resize(values, width, height, dstwidth, dstheight, interp);
+
+    Heightmap heightmap(width, height, values);
+    heightmap.resize(dstwidth, dstheight, interp);
+    ASSERT_EQ(heightmap.getWidth(), dstwidth);
+    ASSERT_EQ(heightmap.getHeight(), dstheight);
+    const float* actual = heightmap.getValues();
+    for (uint i = 0; i < dstwidth * dstheight; i++) {
+        ASSERT_NEAR(actual[i], expected[i], 1e-5f) << "at index " << i;
+    }
+}
+
+TEST(Heightmap, Resize) {
+    for (auto interp :
+         {InterpolationType::NEAREST,
+          InterpolationType::LINEAR,
+          InterpolationType::CUBIC}) {
+        check_resize(16, 16, 64, 64, interp);
+        check_resize(37, 21, 50, 90, interp);
+        check_resize(64, 64, 13, 7, interp);
+        check_resize(1, 1, 8, 8, interp);
+    }
+}
+
+TEST(Heightmap, CropClamp) {
+    std::vector<float> values(8 * 6);
+    for (uint i = 0; i < values.size(); i++) {
+        values[i] = i * 0.1f - 1.5f;
+    }
+    Heightmap heightmap(8, 6, values);
+    heightmap.crop(2, 1, 5, 4);
+    ASSERT_EQ(heightmap.getWidth(), 5);
+    ASSERT_EQ(heightmap.getHeight(), 4);
+    for (uint y = 0; y < 4; y++) {
+        for (uint x = 0; x < 5; x++) {
+            EXPECT_EQ(heightmap.get(x, y), values[(y + 1) * 8 + x + 2]);
+        }
+    }
+    heightmap.clamp();
+    EXPECT_EQ(heightmap.get(0, 0), 0.0f);
+    EXPECT_EQ(heightmap.get(4, 3), 1.0f);
+    EXPECT_FLOAT_EQ(heightmap.get(0, 1), 0.3f);
+}
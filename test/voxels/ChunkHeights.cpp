@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "content/Content.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/Chunk.hpp"
+
+TEST(ChunkHeights, BuildUpdate) {
+    Block air("core:air");
+    air.rt.id = 0;
+    air.rt.solid = false;
+    air.skyLightPassing = true;
+    Block stone("base:stone");
+    stone.rt.id = 1;
+    stone.rt.solid = true;
+    stone.skyLightPassing = false;
+    Block glass("base:glass");
+    glass.rt.id = 2;
+    glass.rt.solid = false;
+    glass.skyLightPassing = true;
+
+    ContentIndices indices(
+        ContentUnitIndices<Block>({&air, &stone, &glass}),
+        ContentUnitIndices<ItemDef>(std::vector<ItemDef*>()),
+        ContentUnitIndices<EntityDef>(std::vector<EntityDef*>())
+    );
+
+    Chunk chunk(0, 0);
+    for (int y = 0; y < 10; y++) {
+        chunk.voxels[vox_index(3, y, 5)].id = 1;
+    }
+    chunk.voxels[vox_index(3, 20, 5)].id = 2;
+    chunk.heights.build(chunk.voxels, indices);
+
+    EXPECT_EQ(chunk.heights.get(HeightmapType::SOLID, 3, 5), 9);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::LIGHT_BLOCKING, 3, 5), 9);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::NON_AIR, 3, 5), 20);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::NON_AIR, 0, 0), -1);
+
+    chunk.voxels[vox_index(3, 20, 5)].id = 0;
+    chunk.heights.update(chunk.voxels, indices, 3, 20, 5);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::NON_AIR, 3, 5), 9);
+
+    chunk.voxels[vox_index(3, 30, 5)].id = 1;
+    chunk.heights.update(chunk.voxels, indices, 3, 30, 5);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::SOLID, 3, 5), 30);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::LIGHT_BLOCKING, 3, 5), 30);
+
+    chunk.voxels[vox_index(3, 9, 5)].id = 0;
+    chunk.heights.update(chunk.voxels, indices, 3, 9, 5);
+    EXPECT_EQ(chunk.heights.get(HeightmapType::SOLID, 3, 5), 30);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "voxels/blocks_agent.hpp"
+
+/// @brief 2x1 chunks storage counting chunk lookups
+class CountingChunks {
+    std::unique_ptr<Chunk> chunks[2];
+    const ContentIndices& indices;
+public:
+    mutable int lookups = 0;
+
+    CountingChunks(const ContentIndices& indices) : indices(indices) {
+        chunks[0] = std::make_unique<Chunk>(0, 0);
+        chunks[1] = std::make_unique<Chunk>(1, 0);
+    }
+
+    Chunk* getChunk(int cx, int cz) const {
+        lookups++;
+        if (cx < 0 || cx > 1 || cz != 0) {
+            return nullptr;
+        }
+        return chunks[cx].get();
+    }
+
+    const ContentIndices& getContentIndices() const {
+        return indices;
+    }
+};
+
+TEST(blocks_agent, ChunksCursor) {
+    Block air("core:air");
+    air.rt.id = 0;
+    air.replaceable = true;
+    Block stone("base:stone");
+    stone.rt.id = 1;
+    stone.size = {3, 3, 3};
+
+    ContentIndices indices(
+        ContentUnitIndices<Block>({&air, &stone}),
+        ContentUnitIndices<ItemDef>(std::vector<ItemDef*>()),
+        ContentUnitIndices<EntityDef>(std::vector<EntityDef*>())
+    );
+    CountingChunks chunks(indices);
+
+    EXPECT_TRUE(blocks_agent::check_replaceability(
+        chunks, stone, {}, {4, 10, 4}, 0
+    ));
+    EXPECT_EQ(chunks.lookups, 1);
+
+    // crossing chunks border
+    chunks.lookups = 0;
+    EXPECT_TRUE(blocks_agent::check_replaceability(
+        chunks, stone, {}, {14, 10, 4}, 0
+    ));
+    EXPECT_EQ(chunks.lookups, 3 * 3 * 2);
+
+    // missing chunk
+    EXPECT_FALSE(blocks_agent::check_replaceability(
+        chunks, stone, {}, {30, 10, 4}, 0
+    ));
+
+    blocks_agent::ChunksCursor cursor(chunks);
+    chunks.lookups = 0;
+    for (int x = 0; x < CHUNK_W * 2; x++) {
+        ASSERT_NE(blocks_agent::get(cursor, x, 0, 0), nullptr);
+    }
+    EXPECT_EQ(blocks_agent::get(cursor, CHUNK_W * 2, 0, 0), nullptr);
+    EXPECT_EQ(chunks.lookups, 3);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <zlib.h>
+
+#include "coders/byte_utils.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "world/files/WorldRegions.hpp"
+#include "world/files/compatibility.hpp"
+
+namespace fs = std::filesystem;
+
+static fs::path prepare_folder() {
+    auto root = fs::temp_directory_path() / "voxelcore_regions_test";
+    fs::remove_all(root);
+    fs::create_directories(root);
+    io::set_device("regionstest", std::make_shared<io::StdfsDevice>(root));
+    return root;
+}
+
+/// @brief Build version 3 region file with given chunks (index, data)
+static util::Buffer<ubyte> build_region_v3(
+    const std::vector<std::pair<size_t, std::string>>& chunks
+) {
+    ByteBuilder builder;
+    builder.put(reinterpret_cast<const ubyte*>(".VOXREG"), 8);
+    builder.put(3); // version
+    builder.put(0); // compression
+    uint32_t offsets[REGION_CHUNKS_COUNT] {};
+    for (const auto& [index, data] : chunks) {
+        offsets[index] = builder.size();
+        builder.putInt32(data.size());
+        builder.putInt32(data.size());
+        builder.put(reinterpret_cast<const ubyte*>(data.data()), data.size());
+    }
+    for (size_t i = 0; i < REGION_CHUNKS_COUNT; i++) {
+        builder.putInt32(offsets[i]);
+    }
+    return util::Buffer<ubyte>(builder.data(), builder.size());
+}
+
+static std::string read_chunk(regfile& file, int index) {
+    uint32_t size = 0;
+    uint32_t srcSize = 0;
+    auto data = file.read(index, size, srcSize);
+    if (data == nullptr) {
+        return "";
+    }
+    EXPECT_EQ(size, srcSize);
+    return std::string(reinterpret_cast<const char*>(data.get()), size);
+}
+
+TEST(world, ConvertRegion3to4) {
+    auto root = prepare_folder();
+    std::vector<std::pair<size_t, std::string>> chunks {
+        {0, "first chunk"}, {5, "second chunk"}, {1023, "last chunk"}
+    };
+    auto v3 = build_region_v3(chunks);
+    io::write_bytes("regionstest:v3.bin", v3.data(), v3.size());
+
+    auto v4 = compatibility::convert_region_3to4(v3);
+    EXPECT_EQ(v4[8], 4);
+    EXPECT_EQ(v4.size(), v3.size() + REGION_CHUNKS_COUNT * 4);
+    io::write_bytes("regionstest:v4.bin", v4.data(), v4.size());
+
+    // version 3 files are read as is
+    regfile v3file("regionstest:v3.bin");
+    regfile v4file("regionstest:v4.bin");
+    EXPECT_EQ(v3file.version, 3);
+    EXPECT_EQ(v4file.version, 4);
+    for (const auto& [index, data] : chunks) {
+        EXPECT_EQ(read_chunk(v3file, index), data);
+        EXPECT_EQ(read_chunk(v4file, index), data);
+    }
+    EXPECT_EQ(read_chunk(v4file, 1), "");
+
+    // chunk offset out of the file
+    auto invalid = build_region_v3(chunks);
+    invalid[invalid.size() - REGION_CHUNKS_COUNT * 4 + 2] = 0xFF;
+    EXPECT_THROW(
+        compatibility::convert_region_3to4(invalid), std::runtime_error
+    );
+    io::remove_device("regionstest");
+    fs::remove_all(root);
+}
+
+TEST(world, RegionChecksumQuarantine) {
+    auto root = prepare_folder();
+    std::string content = "chunk data to be corrupted";
+    auto v4 = compatibility::convert_region_3to4(
+        build_region_v3({{2, "valid chunk"}, {7, content}})
+    );
+    // flip a byte of the 7th chunk data, its size prefixes are intact
+    size_t tableOffset = v4.size() - REGION_CHUNKS_COUNT * 8;
+    uint32_t offset;
+    std::memcpy(&offset, v4.data() + tableOffset + 7 * 8, sizeof(offset));
+    v4[offset + 8 + 3] ^= 0xFF;
+    io::write_bytes("regionstest:1_2.bin", v4.data(), v4.size());
+
+    regfile file("regionstest:1_2.bin");
+    EXPECT_EQ(read_chunk(file, 2), "valid chunk");
+    EXPECT_EQ(read_chunk(file, 7), "");
+
+    auto quarantined = io::read_string("regionstest:quarantine/1_2_7.bin");
+    ASSERT_EQ(quarantined.size(), content.size());
+    EXPECT_NE(quarantined, content);
+    quarantined[3] ^= 0xFF;
+    EXPECT_EQ(quarantined, content);
+    EXPECT_FALSE(io::exists("regionstest:quarantine/1_2_2.bin"));
+
+    io::remove_device("regionstest");
+    fs::remove_all(root);
+}
+
+TEST(world, RegionWriteFailure) {
+    auto root = prepare_folder();
+    RegionsLayer layer {};
+    layer.folder = "regionstest:";
+
+    auto put = [](WorldRegion& region, const std::string& data) {
+        auto bytes = std::make_unique<ubyte[]>(data.size());
+        std::memcpy(bytes.get(), data.data(), data.size());
+        region.put(1, 0, std::move(bytes), data.size(), data.size());
+    };
+    WorldRegion region;
+    put(region, "saved chunk");
+    layer.writeRegion(0, 0, &region);
+
+    // temporary file cannot be created
+    io::create_directories("regionstest:0_0.bin.tmp");
+    WorldRegion changed;
+    put(changed, "changed chunk");
+    EXPECT_THROW(layer.writeRegion(0, 0, &changed), std::runtime_error);
+
+    regfile file("regionstest:0_0.bin");
+    EXPECT_EQ(read_chunk(file, 1), "saved chunk");
+
+    io::remove_device("regionstest");
+    fs::remove_all(root);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "io/devices/StdfsDevice.hpp"
+#include "world/files/WorldBackup.hpp"
+
+namespace fs = std::filesystem;
+
+static fs::path prepare_world() {
+    auto root = fs::temp_directory_path() / "voxelcore_backup_test";
+    fs::remove_all(root);
+    fs::create_directories(root);
+    io::set_device("backuptest", std::make_shared<io::StdfsDevice>(root));
+
+    io::create_directories("backuptest:world/regions");
+    io::write_string("backuptest:world/world.json", "{\"name\": \"test\"}");
+    io::write_string("backuptest:world/regions/0_0.bin", "region 0_0");
+    io::write_string("backuptest:world/regions/1_0.bin", "region 1_0");
+    io::write_string("backuptest:world/regions/2_0.bin.tmp", "unfinished");
+    return root;
+}
+
+static void wait_for(WorldBackup& backup) {
+    while (!backup.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST(world, WorldBackupHardlinks) {
+    auto root = prepare_world();
+    WorldBackup backup("backuptest:world", "backuptest:backup");
+    backup.capture({"regions"}, true);
+    backup.start();
+    wait_for(backup);
+
+    // region files are replaced by rename, other files in place
+    io::write_string("backuptest:world/regions/0_0.bin.tmp", "changed");
+    fs::rename(root / "world/regions/0_0.bin.tmp", root / "world/regions/0_0.bin");
+    io::write_string("backuptest:world/world.json", "{}");
+
+    EXPECT_EQ(io::read_string("backuptest:backup/regions/0_0.bin"), "region 0_0");
+    EXPECT_EQ(io::read_string("backuptest:backup/world.json"), "{\"name\": \"test\"}");
+    EXPECT_FALSE(io::exists("backuptest:backup/regions/2_0.bin.tmp"));
+
+    auto stats = backup.getStats();
+    EXPECT_EQ(stats.filesCopied + stats.filesLinked, 3);
+    io::remove_device("backuptest");
+    fs::remove_all(root);
+}
+
+TEST(world, WorldBackupCopy) {
+    auto root = prepare_world();
+    WorldBackup backup("backuptest:world", "backuptest:backup");
+    backup.capture({"regions"}, false);
+    // preserved before copying is started
+    backup.preserve("backuptest:world/regions/1_0.bin");
+    io::remove("backuptest:world/regions/1_0.bin");
+    backup.start();
+    wait_for(backup);
+
+    EXPECT_EQ(io::read_string("backuptest:backup/regions/0_0.bin"), "region 0_0");
+    EXPECT_EQ(io::read_string("backuptest:backup/regions/1_0.bin"), "region 1_0");
+
+    // preserved file is linked or moved instead of copying
+    auto stats = backup.getStats();
+    EXPECT_EQ(stats.filesCopied, 2);
+    EXPECT_EQ(stats.bytesCopied, 26);
+    EXPECT_EQ(stats.filesLinked + stats.filesMoved, 1);
+    EXPECT_THROW(backup.capture({"regions"}, false), std::runtime_error);
+    io::remove_device("backuptest");
+    fs::remove_all(root);
+}